@@ -0,0 +1,344 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ObjectDominatorTree.h"
+
+#include "ObjectReferenceGraph.h"
+
+#include <Async/Async.h>
+
+namespace ImGuiTools
+{
+	namespace Utils
+	{
+		namespace
+		{
+			// Progress is published and cancellation polled once per this many vertices.
+			static constexpr int32 ProgressInterval = 4096;
+		}
+
+		FObjectDominatorTree::~FObjectDominatorTree()
+		{
+			Cancel();
+		}
+
+		void FObjectDominatorTree::BeginCompute(FObjectReferenceGraph& InGraph, TArray<int32>&& InNodeGroups, TArray<int32>&& InGroupParents)
+		{
+			Cancel();
+
+			if (!InGraph.HasNodeBytes() || !InGraph.BeginQuery())
+			{
+				return;
+			}
+
+			Graph = &InGraph;
+			SnapshotId = InGraph.GetSnapshotId();
+			NodeGroups = MoveTemp(InNodeGroups);
+			GroupParents = MoveTemp(InGroupParents);
+			Progress = 0.0f;
+			State = EState::Computing;
+			ComputeTask = Async(EAsyncExecution::ThreadPool, [this]()
+			{
+				Compute();
+				Graph->EndQuery();
+			});
+		}
+
+		void FObjectDominatorTree::Cancel()
+		{
+			if (ComputeTask.IsValid())
+			{
+				bCancelCompute = true;
+				ComputeTask.Wait();
+				ComputeTask.Reset();
+				bCancelCompute = false;
+			}
+
+			if (GetState() != EState::Ready)
+			{
+				State = EState::Empty;
+			}
+		}
+
+		uint64 FObjectDominatorTree::GetRetainedBytes(int32 NodeIndex) const
+		{
+			return (IsReady() && RetainedBytes.IsValidIndex(NodeIndex)) ? RetainedBytes[NodeIndex] : 0;
+		}
+
+		int32 FObjectDominatorTree::GetImmediateDominator(int32 NodeIndex) const
+		{
+			return (IsReady() && ImmediateDominators.IsValidIndex(NodeIndex)) ? ImmediateDominators[NodeIndex] : INDEX_NONE;
+		}
+
+		uint64 FObjectDominatorTree::GetGroupRetainedBytes(int32 GroupIndex) const
+		{
+			return (IsReady() && GroupRetainedBytes.IsValidIndex(GroupIndex)) ? GroupRetainedBytes[GroupIndex] : 0;
+		}
+
+		void FObjectDominatorTree::Compute()
+		{
+			const auto IsCancelled = [this]() { return bCancelCompute.load() || Graph->IsQueryCancelled(); };
+
+			// Everything below works on DFS numbers from the virtual root, which is vertex 0. Roots are its only successors.
+			const int32 NumNodes = Graph->GetNumNodes();
+			const int32 VirtualRoot = NumNodes;
+			TArray<int32> Roots;
+			for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+			{
+				if (Graph->IsRootNode(NodeIndex))
+				{
+					Roots.Add(NodeIndex);
+				}
+			}
+
+			TArray<int32> DfsNumbers;
+			DfsNumbers.Init(INDEX_NONE, NumNodes + 1);
+			TArray<int32> DfsOrder;		// DFS number -> node
+			TArray<int32> DfsParents;	// DFS number -> DFS number of the spanning tree parent
+			DfsOrder.Reserve(NumNodes + 1);
+			DfsParents.Reserve(NumNodes + 1);
+
+			DfsNumbers[VirtualRoot] = 0;
+			DfsOrder.Add(VirtualRoot);
+			DfsParents.Add(INDEX_NONE);
+
+			TArray<TPair<int32, int32>> DfsStack;	// (node, next successor)
+			DfsStack.Add(TPair<int32, int32>(VirtualRoot, 0));
+			while (DfsStack.Num() > 0)
+			{
+				TPair<int32, int32>& Top = DfsStack.Last();
+				int32 Successor = INDEX_NONE;
+				if (Top.Key == VirtualRoot)
+				{
+					if (Top.Value < Roots.Num())
+					{
+						Successor = Roots[Top.Value++];
+					}
+				}
+				else
+				{
+					const TArrayView<const FObjectReferenceGraph::FReference> References = Graph->GetReferencesView(Top.Key);
+					if (Top.Value < References.Num())
+					{
+						Successor = References[Top.Value++].NodeIndex;
+					}
+				}
+
+				if (Successor == INDEX_NONE)
+				{
+					DfsStack.Pop(false);
+					continue;
+				}
+
+				if (DfsNumbers[Successor] == INDEX_NONE)
+				{
+					const int32 ParentNumber = DfsNumbers[Top.Key];
+					DfsNumbers[Successor] = DfsOrder.Num();
+					DfsOrder.Add(Successor);
+					DfsParents.Add(ParentNumber);
+					DfsStack.Add(TPair<int32, int32>(Successor, 0));
+
+					if ((DfsOrder.Num() % ProgressInterval) == 0)
+					{
+						if (IsCancelled())
+						{
+							State = EState::Empty;
+							return;
+						}
+						Progress = 0.3f * ((float)DfsOrder.Num() / (float)(NumNodes + 1));
+					}
+				}
+			}
+
+			// Lengauer-Tarjan, simple version: semi-dominators in reverse DFS order over a path compressed forest, then fix up
+			//	immediate dominators in DFS order.
+			const int32 NumVertices = DfsOrder.Num();
+			TArray<int32> Semi;
+			TArray<int32> Labels;
+			TArray<int32> Ancestors;
+			TArray<int32> Dominators;
+			TArray<int32> BucketHeads;
+			TArray<int32> BucketNext;
+			Semi.SetNumUninitialized(NumVertices);
+			Labels.SetNumUninitialized(NumVertices);
+			for (int32 i = 0; i < NumVertices; ++i)
+			{
+				Semi[i] = i;
+				Labels[i] = i;
+			}
+			Ancestors.Init(INDEX_NONE, NumVertices);
+			Dominators.Init(INDEX_NONE, NumVertices);
+			BucketHeads.Init(INDEX_NONE, NumVertices);
+			BucketNext.Init(INDEX_NONE, NumVertices);
+
+			TArray<int32> CompressStack;
+			const auto Eval = [&](int32 Vertex)
+			{
+				if (Ancestors[Vertex] == INDEX_NONE)
+				{
+					return Vertex;
+				}
+
+				CompressStack.Reset();
+				for (int32 Current = Vertex; Ancestors[Ancestors[Current]] != INDEX_NONE; Current = Ancestors[Current])
+				{
+					CompressStack.Add(Current);
+				}
+				while (CompressStack.Num() > 0)
+				{
+					const int32 Current = CompressStack.Pop(false);
+					const int32 Ancestor = Ancestors[Current];
+					if (Semi[Labels[Ancestor]] < Semi[Labels[Current]])
+					{
+						Labels[Current] = Labels[Ancestor];
+					}
+					Ancestors[Current] = Ancestors[Ancestor];
+				}
+				return Labels[Vertex];
+			};
+
+			for (int32 Vertex = NumVertices - 1; Vertex > 0; --Vertex)
+			{
+				const int32 NodeIndex = DfsOrder[Vertex];
+				if (Graph->IsRootNode(NodeIndex))
+				{
+					Semi[Vertex] = 0;	// referenced by the virtual root
+				}
+				for (const FObjectReferenceGraph::FReference& Referencer : Graph->GetReferencersView(NodeIndex))
+				{
+					const int32 ReferencerVertex = DfsNumbers[Referencer.NodeIndex];
+					if (ReferencerVertex != INDEX_NONE)
+					{
+						Semi[Vertex] = FMath::Min(Semi[Vertex], Semi[Eval(ReferencerVertex)]);
+					}
+				}
+
+				BucketNext[Vertex] = BucketHeads[Semi[Vertex]];
+				BucketHeads[Semi[Vertex]] = Vertex;
+
+				const int32 Parent = DfsParents[Vertex];
+				Ancestors[Vertex] = Parent;
+				for (int32 Bucketed = BucketHeads[Parent]; Bucketed != INDEX_NONE; Bucketed = BucketNext[Bucketed])
+				{
+					const int32 MinSemi = Eval(Bucketed);
+					Dominators[Bucketed] = (Semi[MinSemi] < Semi[Bucketed]) ? MinSemi : Parent;
+				}
+				BucketHeads[Parent] = INDEX_NONE;
+
+				if ((Vertex % ProgressInterval) == 0)
+				{
+					if (IsCancelled())
+					{
+						State = EState::Empty;
+						return;
+					}
+					Progress = 0.3f + (0.6f * ((float)(NumVertices - Vertex) / (float)NumVertices));
+				}
+			}
+
+			for (int32 Vertex = 1; Vertex < NumVertices; ++Vertex)
+			{
+				if (Dominators[Vertex] != Semi[Vertex])
+				{
+					Dominators[Vertex] = Dominators[Dominators[Vertex]];
+				}
+			}
+
+			// A dominator always has a lower DFS number than the vertices it dominates, so one reverse pass sums every subtree.
+			TArray<uint64> DfsRetainedBytes;
+			DfsRetainedBytes.SetNumZeroed(NumVertices);
+			for (int32 Vertex = NumVertices - 1; Vertex > 0; --Vertex)
+			{
+				DfsRetainedBytes[Vertex] += Graph->GetNodeBytes(DfsOrder[Vertex]);
+				DfsRetainedBytes[Dominators[Vertex]] += DfsRetainedBytes[Vertex];
+			}
+
+			ImmediateDominators.Init(INDEX_NONE, NumNodes);
+			RetainedBytes.SetNumUninitialized(NumNodes);
+			for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+			{
+				const int32 Vertex = DfsNumbers[NodeIndex];
+				RetainedBytes[NodeIndex] = (Vertex != INDEX_NONE) ? DfsRetainedBytes[Vertex] : Graph->GetNodeBytes(NodeIndex);
+				if ((Vertex != INDEX_NONE) && (Dominators[Vertex] > 0))
+				{
+					ImmediateDominators[NodeIndex] = DfsOrder[Dominators[Vertex]];
+				}
+			}
+
+			Progress = 0.9f;
+			AccumulateGroupRetainedBytes(DfsOrder, Dominators, DfsRetainedBytes);
+
+			Progress = 1.0f;
+			State = EState::Ready;
+		}
+
+		void FObjectDominatorTree::AccumulateGroupRetainedBytes(const TArray<int32>& DfsOrder, const TArray<int32>& DfsDominators, const TArray<uint64>& DfsRetainedBytes)
+		{
+			GroupRetainedBytes.Reset();
+			GroupRetainedBytes.SetNumZeroed(GroupParents.Num());
+			if ((GroupParents.Num() == 0) || (NodeGroups.Num() != Graph->GetNumNodes()))
+			{
+				return;
+			}
+
+			// Children of every vertex in the dominator tree (CSR layout).
+			const int32 NumVertices = DfsOrder.Num();
+			TArray<int32> ChildStarts;
+			TArray<int32> Children;
+			ChildStarts.SetNumZeroed(NumVertices + 1);
+			for (int32 Vertex = 1; Vertex < NumVertices; ++Vertex)
+			{
+				++ChildStarts[DfsDominators[Vertex] + 1];
+			}
+			for (int32 Vertex = 0; Vertex < NumVertices; ++Vertex)
+			{
+				ChildStarts[Vertex + 1] += ChildStarts[Vertex];
+			}
+			TArray<int32> ChildCursors(ChildStarts.GetData(), NumVertices);
+			Children.SetNumUninitialized(NumVertices - 1);
+			for (int32 Vertex = 1; Vertex < NumVertices; ++Vertex)
+			{
+				Children[ChildCursors[DfsDominators[Vertex]]++] = Vertex;
+			}
+
+			// Walk the dominator tree keeping count of how many vertices of each group (and its child groups) are open on the path, so a
+			//	vertex only adds its retained bytes to groups it is the outermost member of and nested instances are not counted twice.
+			TArray<int32> OpenCounts;
+			OpenCounts.SetNumZeroed(GroupParents.Num());
+			const auto ForEachGroupOf = [this, &DfsOrder](int32 Vertex, TFunctionRef<void(int32)> Func)
+			{
+				const int32 NodeIndex = DfsOrder[Vertex];
+				for (int32 Group = NodeGroups.IsValidIndex(NodeIndex) ? NodeGroups[NodeIndex] : INDEX_NONE; Group != INDEX_NONE; Group = GroupParents[Group])
+				{
+					Func(Group);
+				}
+			};
+
+			TArray<TPair<int32, int32>> WalkStack;	// (vertex, next child)
+			WalkStack.Add(TPair<int32, int32>(0, ChildStarts[0]));
+			while (WalkStack.Num() > 0)
+			{
+				TPair<int32, int32>& Top = WalkStack.Last();
+				if (Top.Value < ChildStarts[Top.Key + 1])
+				{
+					const int32 Child = Children[Top.Value++];
+					ForEachGroupOf(Child, [this, &OpenCounts, &DfsRetainedBytes, Child](int32 Group)
+					{
+						if (OpenCounts[Group]++ == 0)
+						{
+							GroupRetainedBytes[Group] += DfsRetainedBytes[Child];
+						}
+					});
+					WalkStack.Add(TPair<int32, int32>(Child, ChildStarts[Child]));
+				}
+				else
+				{
+					if (Top.Key != 0)
+					{
+						ForEachGroupOf(Top.Key, [&OpenCounts](int32 Group) { --OpenCounts[Group]; });
+					}
+					WalkStack.Pop(false);
+				}
+			}
+		}
+	}	// namespace Utils
+}	// namespace ImGuiTools
@@ -0,0 +1,70 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Async/Future.h>
+
+#include <atomic>
+
+namespace ImGuiTools
+{
+	namespace Utils
+	{
+		class FObjectReferenceGraph;
+
+		// Dominator tree over a Ready FObjectReferenceGraph, rooted at a virtual node referencing every GC root. The retained size of a
+		//	node is the sum of the exclusive sizes of every node it dominates, i.e. what would be freed if nothing else referenced it.
+		//	Computed on a worker thread with Lengauer-Tarjan, results stay valid for the graph snapshot they were computed from.
+		class FObjectDominatorTree
+		{
+		public:
+			enum class EState : uint8
+			{
+				Empty,
+				Computing,
+				Ready,
+			};
+
+			~FObjectDominatorTree();
+
+			// Start computing dominators of the graph, which must be Ready and have node bytes. NodeGroups optionally maps every node to
+			//	a group (or INDEX_NONE), and GroupParents gives each group's parent with parents before children, to also get the retained
+			//	size of each group including its child groups. Game thread only.
+			void BeginCompute(FObjectReferenceGraph& InGraph, TArray<int32>&& InNodeGroups, TArray<int32>&& InGroupParents);
+			void Cancel();
+
+			EState GetState() const { return State.load(); }
+			bool IsReady() const { return GetState() == EState::Ready; }
+			float GetProgress() const { return Progress.load(); }
+
+			// Graph snapshot the results were computed from.
+			uint32 GetSnapshotId() const { return SnapshotId; }
+
+			// Retained bytes of the node, 0 until Ready. Nodes no GC root reaches only retain themselves.
+			uint64 GetRetainedBytes(int32 NodeIndex) const;
+			int32 GetImmediateDominator(int32 NodeIndex) const;
+
+			// Retained bytes of every node in the group or its child groups, not counting nodes dominated by another node of the same group.
+			uint64 GetGroupRetainedBytes(int32 GroupIndex) const;
+
+		private:
+			void Compute();
+			void AccumulateGroupRetainedBytes(const TArray<int32>& DfsOrder, const TArray<int32>& DfsDominators, const TArray<uint64>& DfsRetainedBytes);
+
+			std::atomic<EState> State { EState::Empty };
+			std::atomic<float> Progress { 0.0f };
+			std::atomic<bool> bCancelCompute { false };
+			uint32 SnapshotId = 0;
+			FObjectReferenceGraph* Graph = nullptr;
+			TFuture<void> ComputeTask;
+
+			TArray<int32> NodeGroups;
+			TArray<int32> GroupParents;
+
+			TArray<int32> ImmediateDominators;	// per node, INDEX_NONE for nodes dominated by the virtual root or not reached
+			TArray<uint64> RetainedBytes;
+			TArray<uint64> GroupRetainedBytes;
+		};
+	}	// namespace Utils
+}	// namespace ImGuiTools
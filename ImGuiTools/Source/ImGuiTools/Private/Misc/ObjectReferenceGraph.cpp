@@ -0,0 +1,526 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ObjectReferenceGraph.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+#include <Algo/Reverse.h>
+#include <Async/Async.h>
+#include <UObject/UObjectArray.h>
+#include <UObject/UnrealType.h>
+
+namespace ImGuiTools
+{
+	namespace Utils
+	{
+		// Records every reference reported for the object currently being collected, along with the property it was found through.
+		class FGraphReferenceCollector : public FReferenceCollector
+		{
+		public:
+			FGraphReferenceCollector(FObjectReferenceGraph& InGraph)
+				: Graph(InGraph)
+			{}
+
+			virtual bool IsIgnoringArchetypeRef() const override { return false; }
+			virtual bool IsIgnoringTransient() const override { return false; }
+
+			virtual void HandleObjectReference(UObject*& InObject, const UObject* InReferencingObject, const FProperty* InReferencingProperty) override
+			{
+				Graph.AddReference(InObject, (InReferencingProperty != nullptr) ? Graph.FindOrAddPropertyName(InReferencingProperty->GetFName()) : INDEX_NONE);
+			}
+
+		private:
+			FObjectReferenceGraph& Graph;
+		};
+
+		namespace
+		{
+			UObject* GetCollectableObject(int32 ObjectIndex)
+			{
+				FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(ObjectIndex);
+				if ((ObjectItem == nullptr) || ObjectItem->IsUnreachable())
+				{
+					return nullptr;
+				}
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+				return static_cast<UObject*>(ObjectItem->GetObject());
+#else	// ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+				return static_cast<UObject*>(ObjectItem->Object);
+#endif	// ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+			}
+		}
+
+		FObjectReferenceGraph::~FObjectReferenceGraph()
+		{
+			Cancel();
+			WaitForQueries();
+		}
+
+		void FObjectReferenceGraph::BeginRefresh()
+		{
+			Cancel();
+			WaitForQueries();
+
+			NumNodes = GUObjectArray.GetObjectArrayNum();
+			CollectCursor = 0;
+			NodeObjects.Reset();
+			NodeObjects.SetNum(NumNodes);
+			RootNodes.Init(false, NumNodes);
+			CapturedNodes.Init(false, NumNodes);
+			StaleNodes.Init(false, NumNodes);
+			NodeBytes.Reset();
+			if (bCollectNodeBytes)
+			{
+				NodeBytes.SetNumZeroed(NumNodes);
+			}
+			ForwardStarts.Reset();
+			ForwardStarts.SetNumUninitialized(NumNodes + 1);
+			ForwardReferences.Reset();
+			ReverseStarts.Reset();
+			ReverseReferences.Reset();
+			PropertyNames.Reset();
+			PropertyNameToIndex.Reset();
+			OuterPropertyIndex = FindOrAddPropertyName(TEXT("(Outer)"));
+			ClassPropertyIndex = FindOrAddPropertyName(TEXT("(Class)"));
+			WatchedNodes.Init(false, NumNodes);
+			StreamedReferencers.Reset();
+
+			State = EState::Collecting;
+		}
+
+		void FObjectReferenceGraph::Cancel()
+		{
+			if (FinalizeTask.IsValid())
+			{
+				FinalizeTask.Wait();
+				FinalizeTask.Reset();
+			}
+
+			if (GetState() != EState::Ready)
+			{
+				State = EState::Empty;
+			}
+		}
+
+		void FObjectReferenceGraph::Tick(float BudgetMs)
+		{
+			if (GetState() != EState::Collecting)
+			{
+				return;
+			}
+
+			const double SliceEndTime = FPlatformTime::Seconds() + (BudgetMs / 1000.0);
+			while (CollectCursor < NumNodes)
+			{
+				const int32 NodeIndex = CollectCursor++;
+				ForwardStarts[NodeIndex] = ForwardReferences.Num();
+
+				UObject* Object = GetCollectableObject(NodeIndex);
+				if (Object == nullptr)
+				{
+					// Referenced ahead of the cursor, but destroyed before the cursor got here.
+					StaleNodes[NodeIndex] = CapturedNodes[NodeIndex];
+				}
+				else if (CaptureNode(NodeIndex, Object))
+				{
+					RootNodes[NodeIndex] = Object->IsRooted() || Object->HasAnyFlags(RF_Standalone) || GUObjectArray.IsDisregardForGC(Object);
+					if (NodeBytes.Num() > 0)
+					{
+						NodeBytes[NodeIndex] = Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+					}
+					CollectingNode = NodeIndex;
+					CollectObjectReferences(Object);
+					CollectingNode = INDEX_NONE;
+				}
+
+				if (((CollectCursor & 0x3F) == 0) && (FPlatformTime::Seconds() > SliceEndTime))
+				{
+					return;
+				}
+			}
+
+			ForwardStarts[NumNodes] = ForwardReferences.Num();
+
+			// Node objects are read from the game thread, so stale nodes are cleared here rather than on the worker.
+			for (TConstSetBitIterator<> It(StaleNodes); It; ++It)
+			{
+				NodeObjects[It.GetIndex()].Reset();
+				RootNodes[It.GetIndex()] = false;
+				if (NodeBytes.Num() > 0)
+				{
+					NodeBytes[It.GetIndex()] = 0;
+				}
+			}
+
+			// Everything the reverse index needs is owned by the graph now, so it can be built off the game thread.
+			State = EState::Finalizing;
+			FinalizeTask = Async(EAsyncExecution::ThreadPool, [this]()
+			{
+				RemoveStaleNodes();
+				BuildReverseIndex();
+				++SnapshotId;
+				State = EState::Ready;
+			});
+		}
+
+		float FObjectReferenceGraph::GetProgress() const
+		{
+			switch (GetState())
+			{
+				case EState::Collecting:	return (NumNodes > 0) ? ((float)CollectCursor / (float)NumNodes) : 0.0f;
+				case EState::Finalizing:	return 1.0f;
+				case EState::Ready:			return 1.0f;
+				default:					return 0.0f;
+			}
+		}
+
+		int32 FObjectReferenceGraph::FindNode(const UObject* Object) const
+		{
+			if ((Object == nullptr) || (GetState() == EState::Empty))
+			{
+				return INDEX_NONE;
+			}
+
+			const int32 NodeIndex = GUObjectArray.ObjectToIndex(Object);
+			return (NodeObjects.IsValidIndex(NodeIndex) && (NodeObjects[NodeIndex].Get() == Object)) ? NodeIndex : INDEX_NONE;
+		}
+
+		UObject* FObjectReferenceGraph::GetNodeObject(int32 NodeIndex) const
+		{
+			return NodeObjects.IsValidIndex(NodeIndex) ? NodeObjects[NodeIndex].Get() : nullptr;
+		}
+
+		FName FObjectReferenceGraph::GetPropertyName(int32 PropertyIndex) const
+		{
+			return PropertyNames.IsValidIndex(PropertyIndex) ? PropertyNames[PropertyIndex] : NAME_None;
+		}
+
+		void FObjectReferenceGraph::GetReferences(int32 NodeIndex, TArray<FReference>& OutReferences) const
+		{
+			OutReferences.Reset();
+			if (IsReady() && (NodeIndex >= 0) && ForwardStarts.IsValidIndex(NodeIndex + 1))
+			{
+				OutReferences.Append(&ForwardReferences[ForwardStarts[NodeIndex]], ForwardStarts[NodeIndex + 1] - ForwardStarts[NodeIndex]);
+			}
+		}
+
+		void FObjectReferenceGraph::GetReferencers(int32 NodeIndex, TArray<FReference>& OutReferencers) const
+		{
+			OutReferencers.Reset();
+			if (IsReady() && (NodeIndex >= 0) && ReverseStarts.IsValidIndex(NodeIndex + 1))
+			{
+				OutReferencers.Append(&ReverseReferences[ReverseStarts[NodeIndex]], ReverseStarts[NodeIndex + 1] - ReverseStarts[NodeIndex]);
+			}
+		}
+
+		void FObjectReferenceGraph::WatchReferencers(int32 NodeIndex)
+		{
+			if ((GetState() != EState::Collecting) || !WatchedNodes.IsValidIndex(NodeIndex) || WatchedNodes[NodeIndex])
+			{
+				return;
+			}
+
+			// Pick up the referencers that were collected before the node was watched.
+			WatchedNodes[NodeIndex] = true;
+			TArray<FReference>& Streamed = StreamedReferencers.FindOrAdd(NodeIndex);
+			for (int32 ReferencerIndex = 0; ReferencerIndex < CollectCursor; ++ReferencerIndex)
+			{
+				const int32 ReferencesEnd = (ReferencerIndex + 1 < CollectCursor) ? ForwardStarts[ReferencerIndex + 1] : ForwardReferences.Num();
+				for (int32 i = ForwardStarts[ReferencerIndex]; i < ReferencesEnd; ++i)
+				{
+					if (ForwardReferences[i].NodeIndex == NodeIndex)
+					{
+						Streamed.Add({ ReferencerIndex, ForwardReferences[i].PropertyIndex });
+					}
+				}
+			}
+		}
+
+		const TArray<FObjectReferenceGraph::FReference>* FObjectReferenceGraph::GetStreamedReferencers(int32 NodeIndex) const
+		{
+			return StreamedReferencers.Find(NodeIndex);
+		}
+
+		void FObjectReferenceGraph::CollectObjectReferences(UObject* Object)
+		{
+			// Same passes the engine's reference finder uses: reflected properties, then native AddReferencedObjects().
+			FGraphReferenceCollector Collector(*this);
+			{
+				FVerySlowReferenceCollectorArchiveScope CollectorScope(Collector.GetVerySlowReferenceCollectorArchive(), Object);
+				Object->SerializeScriptProperties(CollectorScope.GetArchive());
+			}
+			Object->CallAddReferencedObjects(Collector);
+
+			// Inners keep their outer alive, and every object keeps its class alive.
+			AddReference(Object->GetOuter(), OuterPropertyIndex);
+			AddReference(Object->GetClass(), ClassPropertyIndex);
+		}
+
+		void FObjectReferenceGraph::AddReference(const UObject* ReferencedObject, int32 PropertyIndex)
+		{
+			if (ReferencedObject == nullptr)
+			{
+				return;
+			}
+
+			const int32 ReferencedNode = GUObjectArray.ObjectToIndex(ReferencedObject);
+			if ((ReferencedNode == CollectingNode) || (ReferencedNode < 0) || (ReferencedNode >= NumNodes))
+			{
+				return;	// self references, and objects created after the refresh began, are not part of the graph.
+			}
+
+			// Slots behind the cursor that were empty when visited only hold objects created after the refresh began.
+			const bool bVisitedEmptySlot = (ReferencedNode < CollectCursor) && !CapturedNodes[ReferencedNode];
+			if (bVisitedEmptySlot || !CaptureNode(ReferencedNode, ReferencedObject))
+			{
+				return;
+			}
+
+			ForwardReferences.Add({ ReferencedNode, PropertyIndex });
+			if (WatchedNodes[ReferencedNode])
+			{
+				StreamedReferencers.FindOrAdd(ReferencedNode).Add({ CollectingNode, PropertyIndex });
+			}
+		}
+
+		bool FObjectReferenceGraph::CaptureNode(int32 NodeIndex, const UObject* Object)
+		{
+			if (!CapturedNodes[NodeIndex])
+			{
+				CapturedNodes[NodeIndex] = true;
+				NodeObjects[NodeIndex] = Object;
+				return true;
+			}
+
+			if (StaleNodes[NodeIndex])
+			{
+				return false;
+			}
+
+			// A different object in the slot means the one first seen there was destroyed (a GC ran mid-collection) and the slot
+			//	reused. Edges already recorded for that node point at a dead object, so the whole node is dropped when finalizing.
+			if (NodeObjects[NodeIndex].Get(/*bEvenIfPendingKill*/ true) != Object)
+			{
+				StaleNodes[NodeIndex] = true;
+				return false;
+			}
+			return true;
+		}
+
+		void FObjectReferenceGraph::RemoveStaleNodes()
+		{
+			if (StaleNodes.Find(true) == INDEX_NONE)
+			{
+				return;
+			}
+
+			// Compact the forward references in place, dropping every edge from or to a stale node.
+			int32 NumKept = 0;
+			for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+			{
+				const int32 ReferencesBegin = ForwardStarts[NodeIndex];
+				const int32 ReferencesEnd = ForwardStarts[NodeIndex + 1];
+				ForwardStarts[NodeIndex] = NumKept;
+				if (StaleNodes[NodeIndex])
+				{
+					continue;
+				}
+
+				for (int32 i = ReferencesBegin; i < ReferencesEnd; ++i)
+				{
+					if (!StaleNodes[ForwardReferences[i].NodeIndex])
+					{
+						ForwardReferences[NumKept++] = ForwardReferences[i];
+					}
+				}
+			}
+			ForwardStarts[NumNodes] = NumKept;
+			ForwardReferences.SetNum(NumKept);
+		}
+
+		int32 FObjectReferenceGraph::FindOrAddPropertyName(FName PropertyName)
+		{
+			if (const int32* ExistingIndex = PropertyNameToIndex.Find(PropertyName))
+			{
+				return *ExistingIndex;
+			}
+
+			const int32 NewIndex = PropertyNames.Add(PropertyName);
+			PropertyNameToIndex.Add(PropertyName, NewIndex);
+			return NewIndex;
+		}
+
+		void FObjectReferenceGraph::BuildReverseIndex()
+		{
+			// Counting sort of the forward references by referenced node.
+			ReverseStarts.SetNumZeroed(NumNodes + 1);
+			for (const FReference& Reference : ForwardReferences)
+			{
+				++ReverseStarts[Reference.NodeIndex + 1];
+			}
+			for (int32 i = 1; i <= NumNodes; ++i)
+			{
+				ReverseStarts[i] += ReverseStarts[i - 1];
+			}
+
+			TArray<int32> Cursors(ReverseStarts.GetData(), NumNodes);
+			ReverseReferences.SetNumUninitialized(ForwardReferences.Num());
+			for (int32 ReferencerNode = 0; ReferencerNode < NumNodes; ++ReferencerNode)
+			{
+				for (int32 i = ForwardStarts[ReferencerNode]; i < ForwardStarts[ReferencerNode + 1]; ++i)
+				{
+					const FReference& Reference = ForwardReferences[i];
+					ReverseReferences[Cursors[Reference.NodeIndex]++] = { ReferencerNode, Reference.PropertyIndex };
+				}
+			}
+		}
+
+		TFuture<TArray<FObjectReferenceGraph::FPathHop>> FObjectReferenceGraph::FindRootPathAsync(int32 NodeIndex)
+		{
+			if ((NodeIndex < 0) || (NodeIndex >= NumNodes) || !BeginQuery())
+			{
+				TPromise<TArray<FPathHop>> EmptyResult;
+				EmptyResult.SetValue(TArray<FPathHop>());
+				return EmptyResult.GetFuture();
+			}
+
+			return Async(EAsyncExecution::ThreadPool, [this, NodeIndex]()
+			{
+				TArray<FPathHop> Path = FindRootPath(NodeIndex);
+				EndQuery();
+				return Path;
+			});
+		}
+
+		bool FObjectReferenceGraph::BeginQuery()
+		{
+			if (!IsReady())
+			{
+				return false;
+			}
+
+			++NumActiveQueries;
+			return true;
+		}
+
+		void FObjectReferenceGraph::WaitForQueries()
+		{
+			bCancelQueries = true;
+			while (NumActiveQueries.load() > 0)
+			{
+				FPlatformProcess::Sleep(0.0f);
+			}
+			bCancelQueries = false;
+		}
+
+		TArray<FObjectReferenceGraph::FPathHop> FObjectReferenceGraph::FindRootPath(int32 NodeIndex) const
+		{
+			TArray<FPathHop> Path;
+			if (RootNodes[NodeIndex])
+			{
+				Path.Add({ NodeIndex, INDEX_NONE });
+				return Path;
+			}
+
+			// Bidirectional BFS: one search walks referencers back from the node, the other walks references out from every root,
+			//	always expanding whichever frontier is smaller. Each side remembers the neighbour it was reached from, and the
+			//	property of the edge, so the path can be stitched together where they meet.
+			static constexpr int32 Unvisited = -2;
+			static constexpr int32 SearchStart = -1;
+			TArray<FReference> TowardsNode;		// for nodes reached from the node: the node they reference, one step closer to the node
+			TArray<FReference> TowardsRoot;		// for nodes reached from the roots: the node referencing them, one step closer to a root
+			TowardsNode.Init({ Unvisited, INDEX_NONE }, NumNodes);
+			TowardsRoot.Init({ Unvisited, INDEX_NONE }, NumNodes);
+
+			TArray<int32> NodeFrontier;
+			TArray<int32> RootFrontier;
+			TArray<int32> NextFrontier;
+			NodeFrontier.Add(NodeIndex);
+			TowardsNode[NodeIndex] = { SearchStart, INDEX_NONE };
+			for (TConstSetBitIterator<> It(RootNodes); It; ++It)
+			{
+				RootFrontier.Add(It.GetIndex());
+				TowardsRoot[It.GetIndex()] = { SearchStart, INDEX_NONE };
+			}
+
+			int32 MeetingNode = INDEX_NONE;
+			while ((MeetingNode == INDEX_NONE) && (NodeFrontier.Num() > 0) && (RootFrontier.Num() > 0))
+			{
+				if (IsQueryCancelled())
+				{
+					return Path;
+				}
+
+				NextFrontier.Reset();
+				if (NodeFrontier.Num() <= RootFrontier.Num())
+				{
+					for (int32 FrontierIndex = 0; (FrontierIndex < NodeFrontier.Num()) && (MeetingNode == INDEX_NONE); ++FrontierIndex)
+					{
+						const int32 Referenced = NodeFrontier[FrontierIndex];
+						for (int32 i = ReverseStarts[Referenced]; i < ReverseStarts[Referenced + 1]; ++i)
+						{
+							const FReference& Referencer = ReverseReferences[i];
+							if (TowardsNode[Referencer.NodeIndex].NodeIndex != Unvisited)
+							{
+								continue;
+							}
+
+							TowardsNode[Referencer.NodeIndex] = { Referenced, Referencer.PropertyIndex };
+							if (TowardsRoot[Referencer.NodeIndex].NodeIndex != Unvisited)
+							{
+								MeetingNode = Referencer.NodeIndex;
+								break;
+							}
+							NextFrontier.Add(Referencer.NodeIndex);
+						}
+					}
+					Swap(NodeFrontier, NextFrontier);
+				}
+				else
+				{
+					for (int32 FrontierIndex = 0; (FrontierIndex < RootFrontier.Num()) && (MeetingNode == INDEX_NONE); ++FrontierIndex)
+					{
+						const int32 Referencer = RootFrontier[FrontierIndex];
+						for (int32 i = ForwardStarts[Referencer]; i < ForwardStarts[Referencer + 1]; ++i)
+						{
+							const FReference& Reference = ForwardReferences[i];
+							if (TowardsRoot[Reference.NodeIndex].NodeIndex != Unvisited)
+							{
+								continue;
+							}
+
+							TowardsRoot[Reference.NodeIndex] = { Referencer, Reference.PropertyIndex };
+							if (TowardsNode[Reference.NodeIndex].NodeIndex != Unvisited)
+							{
+								MeetingNode = Reference.NodeIndex;
+								break;
+							}
+							NextFrontier.Add(Reference.NodeIndex);
+						}
+					}
+					Swap(RootFrontier, NextFrontier);
+				}
+			}
+
+			if (MeetingNode == INDEX_NONE)
+			{
+				return Path;
+			}
+
+			// Root side, walked backwards from the meeting node and then reversed.
+			for (int32 Current = MeetingNode; TowardsRoot[Current].NodeIndex != SearchStart; Current = TowardsRoot[Current].NodeIndex)
+			{
+				const FReference& Previous = TowardsRoot[Current];
+				Path.Add({ Previous.NodeIndex, Previous.PropertyIndex });
+			}
+			Algo::Reverse(Path);
+
+			// Node side, from the meeting node down to the node itself.
+			for (int32 Current = MeetingNode; Current != SearchStart; Current = TowardsNode[Current].NodeIndex)
+			{
+				Path.Add({ Current, TowardsNode[Current].PropertyIndex });
+			}
+			return Path;
+		}
+	}	// namespace Utils
+}	// namespace ImGuiTools
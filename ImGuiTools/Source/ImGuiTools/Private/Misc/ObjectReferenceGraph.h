@@ -0,0 +1,153 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Async/Future.h>
+#include <UObject/WeakObjectPtr.h>
+
+#include <atomic>
+
+namespace ImGuiTools
+{
+	namespace Utils
+	{
+		// Snapshot of every object to object reference, indexed in both directions, so referencer queries never need to walk the object array.
+		//	Nodes are GUObjectArray indices. References are collected on the game thread a slice at a time under a per-frame budget (serializing
+		//	objects is not safe while the game thread is running), then the reverse index is built on a worker thread. Once Ready, the graph
+		//	does not change until the next refresh, so queries are safe from any thread.
+		class FObjectReferenceGraph
+		{
+		public:
+			enum class EState : uint8
+			{
+				Empty,
+				Collecting,
+				Finalizing,
+				Ready,
+			};
+
+			struct FReference
+			{
+				int32 NodeIndex = INDEX_NONE;		// the other end of the reference
+				int32 PropertyIndex = INDEX_NONE;	// see GetPropertyName(), INDEX_NONE if the reference was not made through a property
+			};
+
+			// One object on a path from a GC root, and the property through which it references the next object on the path.
+			struct FPathHop
+			{
+				int32 NodeIndex = INDEX_NONE;
+				int32 PropertyIndex = INDEX_NONE;	// INDEX_NONE on the last hop
+			};
+
+			~FObjectReferenceGraph();
+
+			// Throw away the current graph and start collecting a new one. Game thread only.
+			void BeginRefresh();
+			void Cancel();
+
+			// Collect references for up to BudgetMs. Game thread only.
+			void Tick(float BudgetMs);
+
+			EState GetState() const { return State.load(); }
+			bool IsReady() const { return GetState() == EState::Ready; }
+			float GetProgress() const;
+
+			// Bumped every time a graph finishes building, so cached query results can tell they are out of date.
+			uint32 GetSnapshotId() const { return SnapshotId; }
+
+			int32 GetNumNodes() const { return NumNodes; }
+
+			// Node of the object, or INDEX_NONE if the object was not part of the snapshot. Game thread only.
+			int32 FindNode(const UObject* Object) const;
+
+			// Object of the node, or nullptr if it has been destroyed since the snapshot. Game thread only.
+			UObject* GetNodeObject(int32 NodeIndex) const;
+
+			FName GetPropertyName(int32 PropertyIndex) const;
+
+			// True for the references every object makes to its outer and class, as opposed to references made through a property.
+			bool IsOuterOrClassReference(const FReference& Reference) const { return (Reference.PropertyIndex != INDEX_NONE) && ((Reference.PropertyIndex == OuterPropertyIndex) || (Reference.PropertyIndex == ClassPropertyIndex)); }
+
+			// All references made by / to the node. Only valid once the graph is Ready.
+			void GetReferences(int32 NodeIndex, TArray<FReference>& OutReferences) const;
+			void GetReferencers(int32 NodeIndex, TArray<FReference>& OutReferencers) const;
+
+			// Same as above without copying, for analyses walking the whole graph. The graph must be Ready and the node valid.
+			TArrayView<const FReference> GetReferencesView(int32 NodeIndex) const { return TArrayView<const FReference>(ForwardReferences.GetData() + ForwardStarts[NodeIndex], ForwardStarts[NodeIndex + 1] - ForwardStarts[NodeIndex]); }
+			TArrayView<const FReference> GetReferencersView(int32 NodeIndex) const { return TArrayView<const FReference>(ReverseReferences.GetData() + ReverseStarts[NodeIndex], ReverseStarts[NodeIndex + 1] - ReverseStarts[NodeIndex]); }
+
+			// When set, the exclusive resource size of every node is recorded while collecting. Takes effect on the next refresh.
+			bool bCollectNodeBytes = false;
+			bool HasNodeBytes() const { return NodeBytes.Num() == NumNodes; }
+			uint64 GetNodeBytes(int32 NodeIndex) const { return NodeBytes.IsValidIndex(NodeIndex) ? NodeBytes[NodeIndex] : 0; }
+
+			// While collecting, referencers of watched nodes are recorded as soon as they are found so the UI can show partial results.
+			//	Game thread only.
+			void WatchReferencers(int32 NodeIndex);
+			const TArray<FReference>* GetStreamedReferencers(int32 NodeIndex) const;
+
+			// True if the node was a GC root when collected: in the root set, RF_Standalone or part of the disregard for GC pool.
+			bool IsRootNode(int32 NodeIndex) const { return RootNodes.IsValidIndex(NodeIndex) && RootNodes[NodeIndex]; }
+
+			// Find the shortest reference path from any GC root to the node on a worker thread. The path starts at the root and ends
+			//	at the node, and is empty if no root reaches the node. Only valid once the graph is Ready, the graph waits for running
+			//	searches before it is refreshed.
+			TFuture<TArray<FPathHop>> FindRootPathAsync(int32 NodeIndex);
+
+			// Worker thread work reading the Ready graph is bracketed by BeginQuery / EndQuery. A refresh cancels running queries and
+			//	waits for them to end, so long queries should poll IsQueryCancelled() and bail out. BeginQuery fails if the graph is not Ready.
+			bool BeginQuery();
+			void EndQuery() { --NumActiveQueries; }
+			bool IsQueryCancelled() const { return bCancelQueries.load(); }
+
+		private:
+			friend class FGraphReferenceCollector;
+
+			void CollectObjectReferences(UObject* Object);
+			void AddReference(const UObject* ReferencedObject, int32 PropertyIndex);
+			int32 FindOrAddPropertyName(FName PropertyName);
+			bool CaptureNode(int32 NodeIndex, const UObject* Object);
+			void RemoveStaleNodes();
+			void BuildReverseIndex();
+			TArray<FPathHop> FindRootPath(int32 NodeIndex) const;
+			void WaitForQueries();
+
+			std::atomic<EState> State { EState::Empty };
+			uint32 SnapshotId = 0;
+			int32 NumNodes = 0;
+			int32 CollectCursor = 0;
+			int32 CollectingNode = INDEX_NONE;
+			TFuture<void> FinalizeTask;
+
+			TArray<FWeakObjectPtr> NodeObjects;
+			TBitArray<> RootNodes;
+
+			// Objects are captured the first time their slot is seen, as a reference target or by the cursor. Slots whose object
+			//	changed or died before collection finished are stale and dropped from the graph.
+			TBitArray<> CapturedNodes;
+			TBitArray<> StaleNodes;
+			TArray<uint64> NodeBytes;
+
+			// Searches running on worker threads against the Ready graph.
+			std::atomic<int32> NumActiveQueries { 0 };
+			std::atomic<bool> bCancelQueries { false };
+
+			// Forward references, grouped by referencing node (CSR layout). NumNodes + 1 offsets.
+			TArray<int32> ForwardStarts;
+			TArray<FReference> ForwardReferences;
+
+			// Reverse references, grouped by referenced node. Built on a worker thread once collection is done.
+			TArray<int32> ReverseStarts;
+			TArray<FReference> ReverseReferences;
+
+			TArray<FName> PropertyNames;
+			TMap<FName, int32> PropertyNameToIndex;
+			int32 OuterPropertyIndex = INDEX_NONE;
+			int32 ClassPropertyIndex = INDEX_NONE;
+
+			TBitArray<> WatchedNodes;
+			TMap<int32, TArray<FReference>> StreamedReferencers;
+		};
+	}	// namespace Utils
+}	// namespace ImGuiTools
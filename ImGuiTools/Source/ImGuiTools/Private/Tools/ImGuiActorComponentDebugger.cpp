@@ -890,6 +890,12 @@ namespace ImGuiActorCompUtils
             }
         }
 
+        FCachedWorldInfo* FindWorldInfo(const UWorld* World)
+        {
+            TryCacheWorlds();
+            return WorldInfos.FindByPredicate([World](const FCachedWorldInfo& WorldInfo) { return (WorldInfo.World.Get() == World); });
+        }
+
         TArray<FCachedWorldInfo>   WorldInfos;
     };
     
@@ -1034,6 +1040,32 @@ void FImGuiActorComponentDebugger::ImGuiUpdate(float DeltaTime)
     }
 }
 
+bool FImGuiActorComponentDebugger::OpenActorWindow(AActor* Actor)
+{
+    ImGuiActorCompUtils::FCachedWorldInfo* WorldInfo = IsValid(Actor) ? CachedWorlds.FindWorldInfo(Actor->GetWorld()) : nullptr;
+    if (WorldInfo == nullptr)
+    {
+        return false;
+    }
+
+    WorldInfo->Display = true;
+    WorldInfo->ActorWindows.AddUnique(TWeakObjectPtr<AActor>(Actor));
+    return true;
+}
+
+bool FImGuiActorComponentDebugger::OpenComponentWindow(UActorComponent* Component)
+{
+    ImGuiActorCompUtils::FCachedWorldInfo* WorldInfo = IsValid(Component) ? CachedWorlds.FindWorldInfo(Component->GetWorld()) : nullptr;
+    if (WorldInfo == nullptr)
+    {
+        return false;
+    }
+
+    WorldInfo->Display = true;
+    WorldInfo->CompWindows.AddUnique(TWeakObjectPtr<UActorComponent>(Component));
+    return true;
+}
+
 void FImGuiActorComponentDebugger::UpdateTool(float DeltaTime)
 {
     FImGuiToolWindow::UpdateTool(DeltaTime);
@@ -6,6 +6,8 @@
 #include "ImGuiToolWindow.h"
 #include "UObject/WeakObjectPtr.h"
 
+class AActor;
+class UActorComponent;
 class UClass;
 class UObject;
 
@@ -38,4 +40,9 @@ public:
 	virtual void ImGuiUpdate(float DeltaTime) override;
 	virtual void UpdateTool(float DeltaTime) override;
 	// FImGuiToolWindow Interface
+
+	// Open a window for the actor / component as if it had been picked in this tool, so other tools can link to it.
+	//	Windows are drawn even while this tool is closed. Returns false if the object's world is not one this tool displays.
+	static bool OpenActorWindow(AActor* Actor);
+	static bool OpenComponentWindow(UActorComponent* Component);
 };
\ No newline at end of file
@@ -7,18 +7,37 @@
 #include "Misc/StreamingTextureLevelContext.h"	// StreamingTexture copy for UE 4.XX where this is not exported in engine. (fixed in UE5)
 #endif // #if ENGINE_MAJOR_VERSION == 4
 
+#include "ImGuiToolsDeveloperSettings.h"
+#include "Misc/ObjectDominatorTree.h"
+#include "Misc/ObjectReferenceGraph.h"
+#include "Tools/ImGuiActorComponentDebugger.h"
 #include "Utils/ImGuiUtils.h"
 
+#include <Async/MappedFileHandle.h>
+#include <Async/ParallelFor.h>
 #include <Components/PrimitiveComponent.h>
+#include <ContentStreaming.h>
 #include <Engine/Texture2D.h>
 #include <Engine/TextureCube.h>
 #include <Engine/TextureLODSettings.h>
 #include <Engine/TextureStreamingTypes.h>
+#include <Engine/World.h>
+#include <GameFramework/Actor.h>
+#include <HAL/PlatformFileManager.h>
+#include <Misc/App.h>
+#include <Misc/FileHelper.h>
+#include <Misc/PackageName.h>
+#include <Misc/Paths.h>
+#include <Misc/ScopeLock.h>
 #include <RenderUtils.h>
+#include <UObject/UObjectArray.h>
+#include <UObject/UObjectHash.h>
 #include <UObject/UObjectIterator.h>
 
 #include <imgui.h>
 
+#include <atomic>
+
 // Log Category
 DEFINE_LOG_CATEGORY_STATIC(LogImGuiDebugMem, Warning, All);
 
@@ -29,6 +48,60 @@ namespace MemDebugUtils
 		return (float) bytes / 1000000.0f;
 	}
 
+	// Append the string to a byte array as UTF-8, without a terminator. Returns the number of bytes appended.
+	template<typename CharType>
+	int32 AppendUtf8(TArray<CharType>& OutBytes, const TCHAR* String)
+	{
+		static_assert(sizeof(CharType) == 1, "AppendUtf8 appends to arrays of bytes.");
+		FTCHARToUTF8 Utf8String(String);
+		OutBytes.Append(reinterpret_cast<const CharType*>(Utf8String.Get()), Utf8String.Length());
+		return Utf8String.Length();
+	}
+
+	// Replace the array with the null terminated UTF-8 string, for ImGui to draw without converting every frame.
+	void CopyUtf8(TArray<ANSICHAR>& OutUtf8, const FString& String)
+	{
+		OutUtf8.Reset(String.Len() + 1);
+		AppendUtf8(OutUtf8, *String);
+		OutUtf8.Add('\0');
+	}
+
+	// The last Capacity samples pushed, with inline storage so arrays of histories stay contiguous.
+	template<typename T, int32 Capacity>
+	struct TRingHistory
+	{
+		void Reset()
+		{
+			Head = 0;
+			NumValid = 0;
+		}
+
+		void Push(const T& Value)
+		{
+			Samples[Head] = Value;
+			Head = (Head + 1) % Capacity;
+			NumValid = FMath::Min(NumValid + 1, Capacity);
+		}
+
+		// Age steps back from the newest sample (Age 0), and must be less than Num().
+		const T& Get(int32 Age) const
+		{
+			checkSlow((Age >= 0) && (Age < NumValid));
+			return Samples[(Head - 1 - Age + Capacity) % Capacity];
+		}
+
+		int32 Num() const { return NumValid; }
+
+		// Raw storage and the offset of the oldest sample, the way ImGui::PlotLines takes a ring buffer.
+		const T* GetData() const { return Samples; }
+		int32 GetOldestOffset() const { return (NumValid < Capacity) ? 0 : Head; }
+
+	private:
+		T Samples[Capacity] = {};
+		int32 Head = 0;			// slot the next sample goes in
+		int32 NumValid = 0;
+	};
+
 	struct FSortedTexture
 	{
 		int32 MaxAllowedSizeX;	  // This is the disk size when cooked.
@@ -43,6 +116,18 @@ namespace MemDebugUtils
 		int32 LODGroup;
 		bool bIsStreaming;
 		int32 UsageCount;
+		bool bIsForced = false;
+		bool bUsageTracked = false;	// only 2D textures are counted by the primitive usage pass
+		int32 SizeX = 0;			// full size of the top mip, 2D textures only
+		int32 SizeY = 0;
+		int32 NumMips = 0;
+		TWeakObjectPtr<UTexture> Texture;
+
+		// Resident, but not used by any primitive component.
+		bool IsUnreferencedResident() const
+		{
+			return bUsageTracked && (UsageCount == 0) && (CurrentSize > 0);
+		}
 
 		/** Constructor, initializing every member variable with passed in values. */
 		FSortedTexture(int32 InMaxAllowedSizeX,
@@ -104,11 +189,13 @@ namespace MemDebugUtils
 		// Class Info
 		TWeakObjectPtr<UClass> Class;
 		bool bAbstract = false;
+		int ParentIndex = INDEX_NONE;
 		TArray<int> ChildIndicies;
 
-		// Current MemReport Info
-		FMemInfo MemInfo;
-		int Instances = 0;
+		// Null terminated UTF-8 class name, cached when the entry is created for display and name filtering.
+		TArray<ANSICHAR> Utf8Name;
+
+		const ANSICHAR* GetUtf8Name() const { return Utf8Name.GetData(); }
 	};
 
 	namespace EColumnTypes
@@ -124,6 +211,8 @@ namespace MemDebugUtils
 			DedVidMem,
 			SharedSysMem,
 			SharedVidMem,
+			RetainedMem,
+			Growth,
 
 			COUNT
 		};
@@ -139,9 +228,122 @@ namespace MemDebugUtils
 			/*DedVidMem*/       true,
 			/*SharedSysMem*/    false,
 			/*SharedVidMem*/    false,
+			/*RetainedMem*/     false,
+			/*Growth*/          false,
 		};
 	}	// namespace EColumnTypes
 
+	// Memory columns, in the order they are stored in saved snapshots.
+	namespace EMemColumn
+	{
+		enum Type
+		{
+			TotalMem = 0,
+			UnknownMem,
+			DedSysMem,
+			DedVidMem,
+			SharedSysMem,
+			SharedVidMem,
+
+			COUNT
+		};
+	}	// namespace EMemColumn
+
+	float BytesToMB(uint64 Bytes)
+	{
+		return (float)((double)Bytes / 1024.0 / 1024.0);
+	}
+
+	// Per-class memory stats stored struct-of-arrays, one contiguous array of exact byte counts per memory column, all indexed by class index.
+	struct FMemColumns
+	{
+		TArray<uint64> Bytes[EMemColumn::COUNT];
+		TArray<int> Instances;
+
+		int Num() const { return Instances.Num(); }
+
+		void Reset(int NumClasses)
+		{
+			for (TArray<uint64>& Column : Bytes)
+			{
+				Column.Reset();
+				Column.SetNumZeroed(NumClasses);
+			}
+			Instances.Reset();
+			Instances.SetNumZeroed(NumClasses);
+		}
+
+		void Empty()
+		{
+			for (TArray<uint64>& Column : Bytes)
+			{
+				Column.Empty();
+			}
+			Instances.Empty();
+		}
+
+		void ResetClass(int ClassIndex)
+		{
+			for (TArray<uint64>& Column : Bytes)
+			{
+				Column[ClassIndex] = 0;
+			}
+			Instances[ClassIndex] = 0;
+		}
+
+		// Move every class to OldToNew[ClassIndex], dropping classes mapped to INDEX_NONE. New indices must keep the old order.
+		void Compact(const TArray<int>& OldToNew, int NewNumClasses)
+		{
+			if (Num() == 0)
+			{
+				return;
+			}
+
+			const int OldNumClasses = FMath::Min(Num(), OldToNew.Num());
+			for (TArray<uint64>& Column : Bytes)
+			{
+				for (int i = 0; i < OldNumClasses; ++i)
+				{
+					if (OldToNew[i] != INDEX_NONE)
+					{
+						Column[OldToNew[i]] = Column[i];
+					}
+				}
+				Column.SetNumZeroed(NewNumClasses);
+			}
+			for (int i = 0; i < OldNumClasses; ++i)
+			{
+				if (OldToNew[i] != INDEX_NONE)
+				{
+					Instances[OldToNew[i]] = Instances[i];
+				}
+			}
+			Instances.SetNumZeroed(NewNumClasses);
+		}
+
+		// Add every class of Other into this, one column at a time.
+		void Accumulate(const FMemColumns& Other)
+		{
+			const int NumClasses = Num();
+			for (int Col = 0; Col < EMemColumn::COUNT; ++Col)
+			{
+				uint64* RESTRICT Dest = Bytes[Col].GetData();
+				const uint64* RESTRICT Src = Other.Bytes[Col].GetData();
+				for (int i = 0; i < NumClasses; ++i)
+				{
+					Dest[i] += Src[i];
+				}
+			}
+
+			int* RESTRICT DestInstances = Instances.GetData();
+			const int* RESTRICT SrcInstances = Other.Instances.GetData();
+			for (int i = 0; i < NumClasses; ++i)
+			{
+				DestInstances[i] += SrcInstances[i];
+			}
+		}
+	};
+
 	namespace EMemSortType
 	{
 		enum Type
@@ -158,693 +360,5057 @@ namespace MemDebugUtils
 		};
 	}	// namespace EMemSortType
 
+	namespace ECaptureMode
+	{
+		enum Type
+		{
+			GameThread = 0,
+			Parallel,
+			TimeSliced,
+		};
+	}	// namespace ECaptureMode
+
+	namespace ECaptureState
+	{
+		enum Type
+		{
+			Idle,
+			Gathering,
+		};
+	}	// namespace ECaptureState
+
+	// Resolve the object in a GUObjectArray slot, or nullptr if the slot is empty, unreachable or still async loading.
+	UObject* GetGatherableObject(int32 ObjectIndex)
+	{
+		FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(ObjectIndex);
+		if ((ObjectItem == nullptr) || ObjectItem->IsUnreachable())
+		{
+			return nullptr;
+		}
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+		if (ObjectItem->HasAnyFlags(EInternalObjectFlags_AsyncLoading))
+		{
+			return nullptr;
+		}
+		return static_cast<UObject*>(ObjectItem->GetObject());
+#else	// ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+		if (ObjectItem->HasAnyFlags(EInternalObjectFlags::AsyncLoading))
+		{
+			return nullptr;
+		}
+		return static_cast<UObject*>(ObjectItem->Object);
+#endif	// ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+	}
+
+	bool ShouldGatherObject(UObject* Object, bool IncludeCDO)
+	{
+#if WITH_EDITORONLY_DATA
+		return !((!IncludeCDO && Object->IsTemplate(RF_ClassDefaultObject)) || !Object->GetPackage()->GetHasBeenEndLoaded());
+#else
+		return !(!IncludeCDO && Object->IsTemplate(RF_ClassDefaultObject));
+#endif
+	}
+
+	// Compact record of a single instance's resource size, kept from a class tree gather so inspectors can open without rescanning.
+	struct FInstanceRecord
+	{
+		FWeakObjectPtr Object;
+		uint32 Bytes[EMemColumn::COUNT];	// saturates at 4GB per instance
+	};
+
+	// Instance records in gather order, along with the class index each record was attributed to.
+	struct FInstanceRecordBuffer
+	{
+		TArray<FInstanceRecord> Records;
+		TArray<int32> ClassIndices;
+
+		void Empty()
+		{
+			Records.Empty();
+			ClassIndices.Empty();
+		}
+
+		void Append(FInstanceRecordBuffer&& Other)
+		{
+			Records.Append(MoveTemp(Other.Records));
+			ClassIndices.Append(MoveTemp(Other.ClassIndices));
+		}
+	};
+
+	// Add the resource size of the object, in bytes, and one instance to the class at ClassIndex. Optionally keep a record of the instance.
+	void AddObjectResourceSize(UObject* Object, EResourceSizeMode::Type ResourceSizeMode, FMemColumns& MemColumns, int ClassIndex, FInstanceRecordBuffer* RecordBuffer = nullptr)
+	{
+		FResourceSizeEx TrueResourceSize = FResourceSizeEx(ResourceSizeMode);
+		Object->GetResourceSizeEx(TrueResourceSize);
+
+		uint64 ObjectBytes[EMemColumn::COUNT] = {};
+		ObjectBytes[EMemColumn::TotalMem] = TrueResourceSize.GetTotalMemoryBytes();
+		ObjectBytes[EMemColumn::UnknownMem] = TrueResourceSize.GetUnknownMemoryBytes();
+		ObjectBytes[EMemColumn::DedSysMem] = TrueResourceSize.GetDedicatedSystemMemoryBytes();
+		ObjectBytes[EMemColumn::DedVidMem] = TrueResourceSize.GetDedicatedVideoMemoryBytes();
+#if ENGINE_MAJOR_VERSION == 4
+		ObjectBytes[EMemColumn::SharedSysMem] = TrueResourceSize.GetSharedSystemMemoryBytes();
+		ObjectBytes[EMemColumn::SharedVidMem] = TrueResourceSize.GetSharedVideoMemoryBytes();
+#endif // #if ENGINE_MAJOR_VERSION == 4
+
+		for (int Col = 0; Col < EMemColumn::COUNT; ++Col)
+		{
+			MemColumns.Bytes[Col][ClassIndex] += ObjectBytes[Col];
+		}
+		++MemColumns.Instances[ClassIndex];
+
+		if (RecordBuffer != nullptr)
+		{
+			FInstanceRecord& Record = RecordBuffer->Records.AddDefaulted_GetRef();
+			Record.Object = Object;
+			for (int Col = 0; Col < EMemColumn::COUNT; ++Col)
+			{
+				Record.Bytes[Col] = (uint32)FMath::Min<uint64>(ObjectBytes[Col], MAX_uint32);
+			}
+			RecordBuffer->ClassIndices.Add(ClassIndex);
+		}
+	}
+
 	struct FCachedClassTree
 	{
-		void TryCacheEntries(bool ForceRecache = false)
+		// A running capture has CaptureListener registered with the object array, which must not outlive the tree.
+		~FCachedClassTree()
+		{
+			CancelCapture();
+		}
+
+		// Make sure every loaded class has an entry. Classes loaded or compiled since the last call are spliced into the existing tree and classes
+		//	that have been destroyed are unlinked, so only a forced recache rebuilds the whole array. Returns true if any cached class went stale.
+		bool TryCacheEntries(bool ForceRecache = false)
 		{
+			if (IsCapturing())
+			{
+				return false;	// class indices must stay stable until the running capture finishes.
+			}
+
+			const uint64 RegisteredClassesVersion = GetRegisteredClassesVersionNumber();
 			if (Classes.Num() > 0)
 			{
 				if (!ForceRecache)
 				{
-					return;
+					if (RegisteredClassesVersion == CachedClassesVersion)
+					{
+						return false;
+					}
+
+					CachedClassesVersion = RegisteredClassesVersion;
+					const bool bAnyStale = UnlinkStaleEntries();
+					if (NumStaleEntries > (Classes.Num() / 4))
+					{
+						CompactStaleEntries();
+					}
+					for (TObjectIterator<UClass> It; It; ++It)
+					{
+						AddClassEntry(*It);
+					}
+					SortBy(SortType);
+					return bAnyStale;
 				}
 				
 				Classes.Empty();
+				ClassToIndex.Empty();
+				RootIndex = INDEX_NONE;
+				NumStaleEntries = 0;
+				++ClassIndexGeneration;
 			}
 
+			CachedClassesVersion = RegisteredClassesVersion;
+			++TreeVersion;
 			for (TObjectIterator<UClass> It; It; ++It)
 			{
-				FCachedClassInfo& ClassInfo = Classes.AddDefaulted_GetRef();
-				ClassInfo.Class = *It;
-				ClassInfo.bAbstract = It->HasAnyClassFlags(CLASS_Abstract);
+				AddClassEntry(*It);
 			}
+			return false;
+		}
 
-			const int NumClasses = Classes.Num();
-			for (int i = 0; i < NumClasses; ++i)
+		// Add an entry for the class (and any of its super classes that are missing), linking it to its parent. Returns the class index.
+		int AddClassEntry(UClass* Class)
+		{
+			if (const int* ExistingIndex = ClassToIndex.Find(Class))
 			{
-				FCachedClassInfo& ClassInfo = Classes[i];
-				if (ClassInfo.Class == UObject::StaticClass())
+				return *ExistingIndex;
+			}
+
+			const int ParentIndex = (Class->GetSuperClass() != nullptr) ? AddClassEntry(Class->GetSuperClass()) : INDEX_NONE;
+
+			const int NewIndex = Classes.Num();
+			ClassToIndex.Add(Class, NewIndex);
+			FCachedClassInfo& ClassInfo = Classes.AddDefaulted_GetRef();
+			ClassInfo.Class = Class;
+			ClassInfo.bAbstract = Class->HasAnyClassFlags(CLASS_Abstract);
+			ClassInfo.ParentIndex = ParentIndex;
+
+			CopyUtf8(ClassInfo.Utf8Name, Class->GetName());
+
+			if (ParentIndex != INDEX_NONE)
+			{
+				Classes[ParentIndex].ChildIndicies.Add(NewIndex);
+			}
+			if (Class == UObject::StaticClass())
+			{
+				RootIndex = NewIndex;
+			}
+
+			return NewIndex;
+		}
+
+		// Unlink entries of destroyed classes from their parents and from the class map. The entries themselves stay in place so indices remain valid.
+		bool UnlinkStaleEntries()
+		{
+			bool bAnyStale = false;
+			for (TMap<const UClass*, int>::TIterator It = ClassToIndex.CreateIterator(); It; ++It)
+			{
+				const int StaleIndex = It.Value();
+				FCachedClassInfo& ClassInfo = Classes[StaleIndex];
+				if (ClassInfo.Class.IsValid())
 				{
-					RootIndex = i;
+					continue;
 				}
 
-				for (int j = 0; j < NumClasses; ++j)
+				if (Classes.IsValidIndex(ClassInfo.ParentIndex))
 				{
-					FCachedClassInfo& PotentialChild = Classes[j];
-					if (PotentialChild.Class.IsValid() && PotentialChild.Class->GetSuperClass() == ClassInfo.Class)
-					{
-						ClassInfo.ChildIndicies.Add(j);
-					}
+					Classes[ClassInfo.ParentIndex].ChildIndicies.Remove(StaleIndex);
 				}
+				ClassInfo.ParentIndex = INDEX_NONE;
+				ClassInfo.ChildIndicies.Empty();
+				It.RemoveCurrent();
+				++NumStaleEntries;
+				bAnyStale = true;
 			}
+			return bAnyStale;
 		}
 
-		void UpdateMemoryStats(bool IncludeCDO, EResourceSizeMode::Type ResourceSizeMode = EResourceSizeMode::Exclusive)
+		// Drop the unlinked entries once enough of them have piled up (e.g. from repeated blueprint recompiles), so the array does
+		//	not grow for the whole session. Live entries keep their order and their stats, but get new indices, so this bumps
+		//	ClassIndexGeneration and drops the instance records. Must not run during a capture.
+		void CompactStaleEntries()
 		{
-			// Caching Class Entires is quick compared to what we are about to do.. refresh latest class info.
-			TryCacheEntries(/*ForceRecache*/true);
+			check(!IsCapturing());
 
-			for (FCachedClassInfo& ClassInfo : Classes)
+			TArray<int> OldToNew;
+			OldToNew.Init(INDEX_NONE, Classes.Num());
+			int NumLive = 0;
+			for (int i = 0; i < Classes.Num(); ++i)
 			{
-				ClassInfo.MemInfo = {};
-				ClassInfo.Instances = 0;
+				if (Classes[i].Class.IsValid())
+				{
+					OldToNew[i] = NumLive++;
+				}
 			}
 
-			for (FThreadSafeObjectIterator It; It; ++It)
+			for (int i = 0; i < Classes.Num(); ++i)
 			{
-#if WITH_EDITORONLY_DATA
-				if ((!IncludeCDO && It->IsTemplate(RF_ClassDefaultObject)) || !It->GetPackage()->GetHasBeenEndLoaded())
-#else
-				if (!IncludeCDO && It->IsTemplate(RF_ClassDefaultObject))
-#endif
+				if (OldToNew[i] == INDEX_NONE)
 				{
 					continue;
 				}
-				FResourceSizeEx TrueResourceSize = FResourceSizeEx(ResourceSizeMode);
-				It->GetResourceSizeEx(TrueResourceSize);
-				for (FCachedClassInfo& ClassInfo : Classes)
+
+				FCachedClassInfo& ClassInfo = Classes[i];
+				ClassInfo.ParentIndex = Classes.IsValidIndex(ClassInfo.ParentIndex) ? OldToNew[ClassInfo.ParentIndex] : INDEX_NONE;
+				for (int& ChildIndex : ClassInfo.ChildIndicies)
 				{
-					if (It->GetClass()->IsChildOf(ClassInfo.Class.Get()))
-					{
-						ClassInfo.MemInfo.TotalMemoryMB += (float) TrueResourceSize.GetTotalMemoryBytes();
-						ClassInfo.MemInfo.UnknownMemoryMB += (float)TrueResourceSize.GetUnknownMemoryBytes();
-						ClassInfo.MemInfo.DedSysMemoryMB += (float)TrueResourceSize.GetDedicatedSystemMemoryBytes();
-						ClassInfo.MemInfo.DedVidMemoryMB += (float)TrueResourceSize.GetDedicatedVideoMemoryBytes();
-#if ENGINE_MAJOR_VERSION == 4
-						ClassInfo.MemInfo.SharedSysMemoryMB += (float)TrueResourceSize.GetSharedSystemMemoryBytes();
-						ClassInfo.MemInfo.SharedVidMemoryMB += (float)TrueResourceSize.GetSharedVideoMemoryBytes();
-#endif // #if ENGINE_MAJOR_VERSION == 4
-						
-						++ClassInfo.Instances;
-					}
+					ChildIndex = OldToNew[ChildIndex];
+				}
+				ClassInfo.ChildIndicies.Remove(INDEX_NONE);
+				if (OldToNew[i] != i)
+				{
+					Classes[OldToNew[i]] = MoveTemp(ClassInfo);
 				}
+			}
+			Classes.SetNum(NumLive);
 
+			for (TPair<const UClass*, int>& Entry : ClassToIndex)
+			{
+				Entry.Value = OldToNew[Entry.Value];
 			}
+			RootIndex = (RootIndex != INDEX_NONE) ? OldToNew[RootIndex] : INDEX_NONE;
+			SelfStats.Compact(OldToNew, NumLive);
+			TotalStats.Compact(OldToNew, NumLive);
+			ResetInstanceRecords();
+
+			NumStaleEntries = 0;
+			++ClassIndexGeneration;
+			++TreeVersion;
+		}
 
-			// convert B to MB
-			for (FCachedClassInfo& ClassInfo : Classes)
+		// Find the cached index of the given class. If the class was loaded after the cache was built, fall back to its closest cached super class.
+		int FindClassIndex(const UClass* Class) const
+		{
+			for (const UClass* TestClass = Class; TestClass != nullptr; TestClass = TestClass->GetSuperClass())
 			{
-				ClassInfo.MemInfo.TotalMemoryMB = ClassInfo.MemInfo.TotalMemoryMB /1024.0f/1024.0f;
-				ClassInfo.MemInfo.UnknownMemoryMB = ClassInfo.MemInfo.UnknownMemoryMB / 1024.0f / 1024.0f;
-				ClassInfo.MemInfo.DedSysMemoryMB = ClassInfo.MemInfo.DedSysMemoryMB / 1024.0f / 1024.0f;
-				ClassInfo.MemInfo.DedVidMemoryMB = ClassInfo.MemInfo.DedVidMemoryMB / 1024.0f / 1024.0f;
-				ClassInfo.MemInfo.SharedSysMemoryMB = ClassInfo.MemInfo.SharedSysMemoryMB / 1024.0f / 1024.0f;
-				ClassInfo.MemInfo.SharedVidMemoryMB = ClassInfo.MemInfo.SharedVidMemoryMB / 1024.0f / 1024.0f;
+				if (const int* FoundIndex = ClassToIndex.Find(TestClass))
+				{
+					return *FoundIndex;
+				}
 			}
+			return INDEX_NONE;
 		}
 
-		void SortBy(EMemSortType::Type SortType)
+		void UpdateMemoryStats(bool IncludeCDO, EResourceSizeMode::Type ResourceSizeMode = EResourceSizeMode::Exclusive, ECaptureMode::Type CaptureMode = ECaptureMode::GameThread)
 		{
-			switch(SortType)
+			const double UpdateStartTime = FPlatformTime::Seconds();
+			CancelCapture();
+			SnapshotResourceSizeMode = ResourceSizeMode;
+
+			// Caching Class Entires is quick compared to what we are about to do.. refresh latest class info.
+			TryCacheEntries();
+
+			SelfStats.Reset(Classes.Num());
+			ResetInstanceRecords();
+			bGatherKeepsRecords = bKeepInstanceRecords;
+
+			// Attribute each object only to its exact class here, the class hierarchy totals are rolled up afterwards.
+			if (CaptureMode == ECaptureMode::Parallel)
 			{
-				case EMemSortType::Alpha:
-					for (FCachedClassInfo& ClassInfo : Classes)
+				GatherMemoryStatsParallel(IncludeCDO, ResourceSizeMode);
+			}
+			else
+			{
+				for (FThreadSafeObjectIterator It; It; ++It)
+				{
+					if (!ShouldGatherObject(*It, IncludeCDO))
 					{
-						ClassInfo.ChildIndicies.Sort([this](int LHS, int RHS) { return GetNameSafe(Classes[LHS].Class.Get()) < GetNameSafe(Classes[RHS].Class.Get()); });
+						continue;
 					}
-					break;
 
-				case EMemSortType::Instances:
-					for (FCachedClassInfo& ClassInfo : Classes)
+					const int ClassIndex = FindClassIndex(It->GetClass());
+					if (ClassIndex == INDEX_NONE)
 					{
-						ClassInfo.ChildIndicies.Sort([this](int LHS, int RHS) { return Classes[LHS].Instances > Classes[RHS].Instances; });
+						continue;
 					}
-					break;
 
-				case EMemSortType::TotalMem:
-					for (FCachedClassInfo& ClassInfo : Classes)
-					{
-						ClassInfo.ChildIndicies.Sort([this](int LHS, int RHS) { return Classes[LHS].MemInfo.TotalMemoryMB > Classes[RHS].MemInfo.TotalMemoryMB; });
-					}
-					break;
+					AddObjectResourceSize(*It, ResourceSizeMode, SelfStats, ClassIndex, GetGatherRecordBuffer());
+				}
+			}
 
-				case EMemSortType::UnknownMem:
-					for (FCachedClassInfo& ClassInfo : Classes)
+			FinalizeMemoryStats(UpdateStartTime);
+		}
+
+		// Turn the gathered exact class stats into displayable hierarchy totals.
+		void FinalizeMemoryStats(double UpdateStartTime)
+		{
+			// Roll exact class totals up the hierarchy once, so each class includes all of its descendants.
+			TotalStats = SelfStats;
+			RollupChildStats();
+			BuildInstanceRecords();
+			++TreeVersion;
+			++StatsVersion;
+
+			LastUpdateDurationMs = (FPlatformTime::Seconds() - UpdateStartTime) * 1000.0;
+		}
+
+		// Per-chunk accumulation buffers for the parallel gather, indexed by class index. Merged into the class infos once all chunks are done.
+		struct FGatherChunk
+		{
+			FMemColumns MemColumns;
+			FInstanceRecordBuffer RecordBuffer;
+			TArray<UObject*> GameThreadObjects;	// objects of classes opted out of the parallel gather
+		};
+
+		void GatherMemoryStatsParallel(bool IncludeCDO, EResourceSizeMode::Type ResourceSizeMode)
+		{
+			const int NumClasses = Classes.Num();
+
+			// Flag classes whose GetResourceSizeEx() is not safe to call off the game thread. Child classes inherit the flag.
+			TBitArray<> GameThreadOnlyClasses(false, NumClasses);
+			const UImGuiToolsDeveloperSettings* ToolsSettings = GetDefault<UImGuiToolsDeveloperSettings>();
+			for (const TSoftClassPtr<UObject>& OptOutSoftClass : ToolsSettings->MemoryDebuggerGameThreadOnlyClasses)
+			{
+				const UClass* OptOutClass = OptOutSoftClass.Get();
+				if (OptOutClass == nullptr)
+				{
+					continue;	// not loaded, so there are no instances to worry about.
+				}
+
+				for (int i = 0; i < NumClasses; ++i)
+				{
+					const UClass* Class = Classes[i].Class.Get();
+					if ((Class != nullptr) && Class->IsChildOf(OptOutClass))
 					{
-						ClassInfo.ChildIndicies.Sort([this](int LHS, int RHS) { return Classes[LHS].MemInfo.UnknownMemoryMB > Classes[RHS].MemInfo.UnknownMemoryMB; });
+						GameThreadOnlyClasses[i] = true;
 					}
-					break;
+				}
+			}
 
-				case EMemSortType::DedSysMem:
-					for (FCachedClassInfo& ClassInfo : Classes)
+			// One chunk per worker (plus the game thread, which helps out in ParallelFor), each with its own buffers so there is no contention.
+			//	The game thread is blocked for the duration, so GC can not run and purge objects from under the workers.
+			const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+			const int32 NumChunks = FMath::Clamp(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, 1, FMath::Max(NumObjects, 1));
+			const int32 ChunkSize = FMath::DivideAndRoundUp(NumObjects, NumChunks);
+
+			TArray<FGatherChunk> Chunks;
+			Chunks.SetNum(NumChunks);
+			ParallelFor(NumChunks, [&](int32 ChunkIndex)
+			{
+				FGatherChunk& Chunk = Chunks[ChunkIndex];
+				Chunk.MemColumns.Reset(NumClasses);
+
+				const int32 ChunkEnd = FMath::Min((ChunkIndex + 1) * ChunkSize, NumObjects);
+				for (int32 ObjectIndex = ChunkIndex * ChunkSize; ObjectIndex < ChunkEnd; ++ObjectIndex)
+				{
+					UObject* Object = GetGatherableObject(ObjectIndex);
+					if ((Object == nullptr) || !ShouldGatherObject(Object, IncludeCDO))
 					{
-						ClassInfo.ChildIndicies.Sort([this](int LHS, int RHS) { return Classes[LHS].MemInfo.DedSysMemoryMB > Classes[RHS].MemInfo.DedSysMemoryMB; });
+						continue;
 					}
-					break;
 
-				case EMemSortType::DedVidMem:
-					for (FCachedClassInfo& ClassInfo : Classes)
+					const int ClassIndex = FindClassIndex(Object->GetClass());
+					if (ClassIndex == INDEX_NONE)
 					{
-						ClassInfo.ChildIndicies.Sort([this](int LHS, int RHS) { return Classes[LHS].MemInfo.DedVidMemoryMB > Classes[RHS].MemInfo.DedVidMemoryMB; });
+						continue;
 					}
-					break;
 
-				case EMemSortType::SharedSysMem:
-					for (FCachedClassInfo& ClassInfo : Classes)
+					if (GameThreadOnlyClasses[ClassIndex])
 					{
-						ClassInfo.ChildIndicies.Sort([this](int LHS, int RHS) { return Classes[LHS].MemInfo.SharedSysMemoryMB > Classes[RHS].MemInfo.SharedSysMemoryMB; });
+						Chunk.GameThreadObjects.Add(Object);
+						continue;
 					}
-					break;
 
-				case EMemSortType::SharedVidMem:
-					for (FCachedClassInfo& ClassInfo : Classes)
-					{
-						ClassInfo.ChildIndicies.Sort([this](int LHS, int RHS) { return Classes[LHS].MemInfo.SharedVidMemoryMB > Classes[RHS].MemInfo.SharedVidMemoryMB; });
-					}
-					break;
+					AddObjectResourceSize(Object, ResourceSizeMode, Chunk.MemColumns, ClassIndex, bGatherKeepsRecords ? &Chunk.RecordBuffer : nullptr);
+				}
+			});
 
-				default:
-					UE_LOG(LogImGuiDebugMem, Error, TEXT("FCachedClassTree::SortBy() - sorting with unimplemented type. not doing anything!"));
-					break;
+			// Merge the chunks, and gather the objects that had to wait for the game thread.
+			for (FGatherChunk& Chunk : Chunks)
+			{
+				SelfStats.Accumulate(Chunk.MemColumns);
+				GatheredRecords.Append(MoveTemp(Chunk.RecordBuffer));
+
+				for (UObject* Object : Chunk.GameThreadObjects)
+				{
+					AddObjectResourceSize(Object, ResourceSizeMode, SelfStats, FindClassIndex(Object->GetClass()), GetGatherRecordBuffer());
+				}
 			}
 		}
 
-		int RootIndex;
-		TArray<FCachedClassInfo> Classes;
-	};
+		///////////////////////////////////////
+		/////////  Time-sliced capture
+		//	Walks GUObjectArray a slice at a time under a per-frame budget. Objects created or destroyed behind the capture cursor
+		//	while the capture runs mark their class dirty, and dirty classes are re-gathered from the object hash when the capture finishes.
 
-	// Struct for each instance in the list of all instances per-class
-	struct FInstanceInspectorInstanceInfo
-	{
-		TWeakObjectPtr<UObject> InstanceWkPtr = nullptr;
-		FMemInfo MemInfo;
-	};
+		bool IsCapturing() const
+		{
+			return CaptureState == ECaptureState::Gathering;
+		}
 
-	// holds referencer info in a memory safe way
-	struct FReferencerInfo
-	{
-		TWeakObjectPtr<UObject> ReferencerWkPtr = nullptr;
-		TArray<FString> ReferencingProperties;
-		int TotalReferences = 0;
-	};
+		float GetCaptureProgress() const
+		{
+			const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+			return (NumObjects > 0) ? FMath::Clamp((float)CaptureCursor.load() / (float)NumObjects, 0.0f, 1.0f) : 1.0f;
+		}
 
-	// Struct for a single inspected instance
-	struct FInspectedInstanceInfo
-	{
-		TWeakObjectPtr<UObject> InspectedWkPtr = nullptr;
-		TArray<FReferencerInfo> CachedInternalReferencers;
-		TArray<FReferencerInfo> CachedExternalReferencers;
+		void BeginCapture(bool IncludeCDO, EResourceSizeMode::Type ResourceSizeMode)
+		{
+			if (IsCapturing())
+			{
+				return;
+			}
 
-		void UpdateInspectedInstanceReferencers()
+			CaptureStartTime = FPlatformTime::Seconds();
+			TryCacheEntries();
+
+			CaptureIncludeCDO = IncludeCDO;
+			CaptureResourceSizeMode = ResourceSizeMode;
+			SnapshotResourceSizeMode = ResourceSizeMode;
+			CaptureStats.Reset(Classes.Num());
+			ResetInstanceRecords();
+			bGatherKeepsRecords = bKeepInstanceRecords;
+			DirtyClassIndices.Reset();
+			UnmappedClassIndices.Reset();
+			bUnmappedClassDirty = false;
+			CaptureCursor = 0;
+			CaptureState = ECaptureState::Gathering;
+
+			CaptureListener.Tree = this;
+			GUObjectArray.AddUObjectCreateListener(&CaptureListener);
+			GUObjectArray.AddUObjectDeleteListener(&CaptureListener);
+		}
+
+		void CancelCapture()
 		{
-			// This caching exists because FReferencerInformation holds raw UObject pointers and UObject::RetrieveReferencers() is slllooooww
-			//  so just run it on demand and cache the results in 
-			CachedInternalReferencers.Empty();
-			CachedExternalReferencers.Empty();
+			if (IsCapturing())
+			{
+				RemoveCaptureListener();
+				CaptureState = ECaptureState::Idle;
+			}
+		}
 
-			UObject* InspectedInstanceRawPtr = InspectedWkPtr.Get();
-			if (IsValid(InspectedInstanceRawPtr))
+		// Progress the current capture by up to CaptureBudgetMs. Returns true on the frame the capture completes.
+		bool TickCapture()
+		{
+			if (!IsCapturing() || (LastCaptureTickFrame == GFrameCounter))
 			{
-				TArray<FReferencerInformation> ReferencerInfos_Internal;
-				TArray<FReferencerInformation> ReferencerInfos_External;
-				InspectedInstanceRawPtr->RetrieveReferencers(&ReferencerInfos_Internal, &ReferencerInfos_External);
+				return false;
+			}
+			LastCaptureTickFrame = GFrameCounter;
 
-				for (const FReferencerInformation& ReferencerInternal : ReferencerInfos_Internal)
-				{
-					FReferencerInfo& NewReferencerInfo = CachedInternalReferencers.AddDefaulted_GetRef();
-					
-					NewReferencerInfo.ReferencerWkPtr = ReferencerInternal.Referencer;
-					NewReferencerInfo.TotalReferences = ReferencerInternal.TotalReferences;
+			const double SliceEndTime = FPlatformTime::Seconds() + (CaptureBudgetMs / 1000.0);
+			int32 ObjectIndex = CaptureCursor.load();
+			while (ObjectIndex < GUObjectArray.GetObjectArrayNum())
+			{
+				// Advance the cursor before reading the slot, so an object created in this slot from another thread is always flagged dirty.
+				CaptureCursor = ObjectIndex + 1;
 
-					for (const FProperty* ReferencingProperty : ReferencerInternal.ReferencingProperties)
+				UObject* Object = GetGatherableObject(ObjectIndex);
+				if ((Object != nullptr) && ShouldGatherObject(Object, CaptureIncludeCDO))
+				{
+					const UClass* ObjectClass = Object->GetClass();
+					const int ClassIndex = FindClassIndex(ObjectClass);
+					if (ClassIndex != INDEX_NONE)
 					{
-						NewReferencerInfo.ReferencingProperties.Add(ReferencingProperty->GetNameCPP());
+						if (!ClassToIndex.Contains(ObjectClass))
+						{
+							UnmappedClassIndices.Add(ClassIndex);
+						}
+						AddObjectResourceSize(Object, CaptureResourceSizeMode, CaptureStats, ClassIndex, GetGatherRecordBuffer());
 					}
 				}
+
+				++ObjectIndex;
+				if (((ObjectIndex & 0xFF) == 0) && (FPlatformTime::Seconds() > SliceEndTime))
+				{
+					return false;
+				}
 			}
+
+			FinishCapture();
+			return true;
 		}
 
-		void SetInpectedInstance(const TWeakObjectPtr<UObject>& NewInpectedInstance)
+		void FinishCapture()
 		{
-			if (NewInpectedInstance.IsValid())
+			RemoveCaptureListener();
+			CaptureState = ECaptureState::Idle;
+
+			// Objects of unmapped (newly loaded) classes were counted against their closest cached super class, so if one of those was
+			//	destroyed, every class that received unmapped objects has to be re-gathered, including derived classes.
+			TMap<int, bool> ClassesToRegather;
 			{
-				InspectedWkPtr = NewInpectedInstance;
-				UpdateInspectedInstanceReferencers();
+				FScopeLock DirtyLock(&DirtyClassesCS);
+				for (int DirtyIndex : DirtyClassIndices)
+				{
+					ClassesToRegather.Add(DirtyIndex, UnmappedClassIndices.Contains(DirtyIndex));
+				}
+				if (bUnmappedClassDirty)
+				{
+					for (int UnmappedIndex : UnmappedClassIndices)
+					{
+						ClassesToRegather.Add(UnmappedIndex, true);
+					}
+				}
 			}
-		}
-	};
-
-	struct FInstanceInspectorInfo
-	{
-		TWeakObjectPtr<UClass> Class = nullptr;
-		FMemInfo MemInfo;
-		int Instances = 0;
-		EMemSortType::Type SortType = EMemSortType::TotalMem;
-		ImGuiTools::Utils::FShowCols ShowCols = ImGuiTools::Utils::FShowCols(EColumnTypes::COUNT, &EColumnTypes::DefaultVisibility[0]);
-		FInspectedInstanceInfo InspectedInstance;
-		TArray<FInstanceInspectorInstanceInfo> InstanceInfos;
-		ImGuiTextFilter NameFilter;
-		bool bAutoRefresh = false;	// option to auto refresh the instance view
-		float AutoRefreshTime = 4.0f; // interval to auto refresh the instance view
-		float AutoRefreshTimer = 0.0f;	// current timer from last time auto refresh occurred.
 
-		void UpdateObjectMemoryInfo(bool IncludeCDO, EResourceSizeMode::Type ResourceSizeMode = EResourceSizeMode::Exclusive)
-		{
-			MemInfo = {};
-			Instances = 0;
-			InstanceInfos.Empty();
+			// Records of re-gathered classes are collected again below, drop the ones from the time-sliced pass.
+			if (ClassesToRegather.Num() > 0)
+			{
+				int32 KeptRecords = 0;
+				for (int32 i = 0; i < GatheredRecords.Records.Num(); ++i)
+				{
+					if (!ClassesToRegather.Contains(GatheredRecords.ClassIndices[i]))
+					{
+						GatheredRecords.Records[KeptRecords] = MoveTemp(GatheredRecords.Records[i]);
+						GatheredRecords.ClassIndices[KeptRecords] = GatheredRecords.ClassIndices[i];
+						++KeptRecords;
+					}
+				}
+				GatheredRecords.Records.SetNum(KeptRecords);
+				GatheredRecords.ClassIndices.SetNum(KeptRecords);
+			}
 
-			for (FThreadSafeObjectIterator It; It; ++It)
+			for (const TPair<int, bool>& Regather : ClassesToRegather)
 			{
-				if (!It->GetClass()->IsChildOf(Class.Get()) || (!IncludeCDO && It->IsTemplate(RF_ClassDefaultObject)))
+				const int ClassIndex = Regather.Key;
+				UClass* Class = Classes[ClassIndex].Class.Get();
+				CaptureStats.ResetClass(ClassIndex);
+				if (Class == nullptr)
 				{
 					continue;
 				}
 
-				FResourceSizeEx TrueResourceSize = FResourceSizeEx(ResourceSizeMode);
-				It->GetResourceSizeEx(TrueResourceSize);
-				const float InstTotalMemMB = (float)TrueResourceSize.GetTotalMemoryBytes()/1024.0f/1024.0f;
-				const float InstUnknownMemMB = (float)TrueResourceSize.GetUnknownMemoryBytes() / 1024.0f / 1024.0f;
-				const float InstDedSysMemMB = (float)TrueResourceSize.GetDedicatedSystemMemoryBytes() / 1024.0f / 1024.0f;
-				const float InstDedVidMemMB = (float)TrueResourceSize.GetDedicatedVideoMemoryBytes() / 1024.0f / 1024.0f;
-#if ENGINE_MAJOR_VERSION == 4
-				const float InstSharedSysMemMB = (float)TrueResourceSize.GetSharedSystemMemoryBytes() / 1024.0f / 1024.0f;
-				const float InstSharedVidMemMB = (float)TrueResourceSize.GetSharedVideoMemoryBytes() / 1024.0f / 1024.0f;
-#endif // #if ENGINE_MAJOR_VERSION == 4
-				MemInfo.TotalMemoryMB += InstTotalMemMB;
-				MemInfo.UnknownMemoryMB += InstUnknownMemMB;
-				MemInfo.DedSysMemoryMB += InstDedSysMemMB;
-				MemInfo.DedVidMemoryMB += InstDedVidMemMB;
-#if ENGINE_MAJOR_VERSION == 4
-				MemInfo.SharedSysMemoryMB += InstSharedSysMemMB;
-				MemInfo.SharedVidMemoryMB += InstSharedVidMemMB;
-#endif // #if ENGINE_MAJOR_VERSION == 4
-				++Instances;
-
-				FInstanceInspectorInstanceInfo& InstInfo = InstanceInfos.AddZeroed_GetRef();
-				InstInfo.InstanceWkPtr = *It;
-				InstInfo.MemInfo.TotalMemoryMB = InstTotalMemMB;
-				InstInfo.MemInfo.UnknownMemoryMB = InstUnknownMemMB;
-				InstInfo.MemInfo.DedSysMemoryMB = InstDedSysMemMB;
-				InstInfo.MemInfo.DedVidMemoryMB = InstDedVidMemMB;
-#if ENGINE_MAJOR_VERSION == 4
-				InstInfo.MemInfo.SharedSysMemoryMB = InstSharedSysMemMB;
-				InstInfo.MemInfo.SharedVidMemoryMB = InstSharedVidMemMB;
-#endif // #if ENGINE_MAJOR_VERSION == 4
+				ForEachObjectOfClass(Class, [this, ClassIndex](UObject* Object)
+				{
+					if (ShouldGatherObject(Object, CaptureIncludeCDO) && (FindClassIndex(Object->GetClass()) == ClassIndex))
+					{
+						AddObjectResourceSize(Object, CaptureResourceSizeMode, CaptureStats, ClassIndex, GetGatherRecordBuffer());
+					}
+				}, /*bIncludeDerivedClasses*/ Regather.Value, RF_NoFlags);
 			}
 
+			SelfStats = MoveTemp(CaptureStats);
+			CaptureStats.Empty();
+			FinalizeMemoryStats(CaptureStartTime);
 			SortBy(SortType);
 		}
 
-		void SortBy(EMemSortType::Type InSortType)
+		// Called from any thread that creates or destroys a UObject while a capture is running.
+		void OnCaptureObjectChanged(const UObjectBase* Object, int32 Index, bool bDeleted)
 		{
-			SortType = InSortType;
-			switch (SortType)
+			if (Index >= CaptureCursor.load())
 			{
-				case EMemSortType::Alpha:
-					InstanceInfos.Sort([this](const FInstanceInspectorInstanceInfo& LHS, const FInstanceInspectorInstanceInfo& RHS) { return LHS.InstanceWkPtr->GetName() < RHS.InstanceWkPtr->GetName(); });
-					break;
+				return;	// The capture has not reached this slot yet and will see the change itself.
+			}
 
-				case EMemSortType::TotalMem:
-					InstanceInfos.Sort([this](const FInstanceInspectorInstanceInfo& LHS, const FInstanceInspectorInstanceInfo& RHS) { return LHS.MemInfo.TotalMemoryMB > RHS.MemInfo.TotalMemoryMB; });
-					break;
+			// Deleted objects may outlive their class during a GC purge, so only resolve classes we have cached directly.
+			const UClass* ObjectClass = Object->GetClass();
+			const int* CachedIndex = ClassToIndex.Find(ObjectClass);
+			const int ClassIndex = (CachedIndex != nullptr) ? *CachedIndex : (bDeleted ? INDEX_NONE : FindClassIndex(ObjectClass));
 
-				case EMemSortType::UnknownMem:
-					InstanceInfos.Sort([this](const FInstanceInspectorInstanceInfo& LHS, const FInstanceInspectorInstanceInfo& RHS) { return LHS.MemInfo.UnknownMemoryMB > RHS.MemInfo.UnknownMemoryMB; });
-					break;
+			FScopeLock DirtyLock(&DirtyClassesCS);
+			if (ClassIndex != INDEX_NONE)
+			{
+				DirtyClassIndices.Add(ClassIndex);
+			}
+			if (CachedIndex == nullptr)
+			{
+				bUnmappedClassDirty = true;
+			}
+		}
 
-				case EMemSortType::DedSysMem:
-					InstanceInfos.Sort([this](const FInstanceInspectorInstanceInfo& LHS, const FInstanceInspectorInstanceInfo& RHS) { return LHS.MemInfo.DedSysMemoryMB > RHS.MemInfo.DedSysMemoryMB; });
-					break;
+		void RemoveCaptureListener()
+		{
+			GUObjectArray.RemoveUObjectCreateListener(&CaptureListener);
+			GUObjectArray.RemoveUObjectDeleteListener(&CaptureListener);
+		}
 
-				case EMemSortType::DedVidMem:
-					InstanceInfos.Sort([this](const FInstanceInspectorInstanceInfo& LHS, const FInstanceInspectorInstanceInfo& RHS) { return LHS.MemInfo.DedVidMemoryMB > RHS.MemInfo.DedVidMemoryMB; });
-					break;
+		struct FCaptureListener : public FUObjectArray::FUObjectCreateListener, public FUObjectArray::FUObjectDeleteListener
+		{
+			virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override { Tree->OnCaptureObjectChanged(Object, Index, /*bDeleted*/ false); }
+			virtual void NotifyUObjectDeleted(const UObjectBase* Object, int32 Index) override { Tree->OnCaptureObjectChanged(Object, Index, /*bDeleted*/ true); }
+			virtual void OnUObjectArrayShutdown() override { Tree->CancelCapture(); }
 
-				case EMemSortType::SharedSysMem:
-					InstanceInfos.Sort([this](const FInstanceInspectorInstanceInfo& LHS, const FInstanceInspectorInstanceInfo& RHS) { return LHS.MemInfo.SharedSysMemoryMB > RHS.MemInfo.SharedSysMemoryMB; });
-					break;
+			FCachedClassTree* Tree = nullptr;
+		};
 
-				case EMemSortType::SharedVidMem:
-					InstanceInfos.Sort([this](const FInstanceInspectorInstanceInfo& LHS, const FInstanceInspectorInstanceInfo& RHS) { return LHS.MemInfo.SharedVidMemoryMB > RHS.MemInfo.SharedVidMemoryMB; });
-					break;
+		///////////////////////////////////////
+		/////////  Instance records
+		//	When enabled, every gather also keeps a compact record per instance. Records are sorted into one arena grouped by class,
+		//	so an inspector can take its class's slice without a rescan, and the whole arena is released at once on the next gather.
 
-				default:
-				case EMemSortType::Instances:
-					UE_LOG(LogImGuiDebugMem, Error, TEXT("FInstanceInspectorInfo::SortBy() - sorting with unimplemented type. not doing anything!"));
-					break;
-			}
+		FInstanceRecordBuffer* GetGatherRecordBuffer()
+		{
+			return bGatherKeepsRecords ? &GatheredRecords : nullptr;
 		}
-	};
 
-	TArray<FInstanceInspectorInfo> InstanceInspectors;
-	TWeakObjectPtr<UClass> PopupClass;
-	bool DrawClassChildTreeIndex(FCachedClassTree& ClassTree, int Index, bool FilterZeroInstances, ImGuiTextFilter& ClassNameFilter, ImGuiTools::Utils::FShowCols& ShowCols)
-	{
-		FCachedClassInfo& CachedClassInfo = ClassTree.Classes[Index];
-		if (CachedClassInfo.Class.IsStale() || !CachedClassInfo.Class.IsValid())
+		void ResetInstanceRecords()
 		{
-			return false; // return false when data is bad ( or child data is bad )
+			GatheredRecords.Empty();
+			InstanceRecords.Empty();
+			InstanceRecordStarts.Empty();
 		}
 
-		if (FilterZeroInstances && (CachedClassInfo.Instances == 0))
+		bool HasInstanceRecords() const
 		{
-			return true;
+			return InstanceRecordStarts.Num() > 0;
 		}
 
-		if (ClassNameFilter.IsActive())
+		// Counting sort the gathered records by class index into the arena.
+		void BuildInstanceRecords()
 		{
-			if (!ClassNameFilter.PassFilter(TCHAR_TO_ANSI(*CachedClassInfo.Class->GetName())))
+			if (GatheredRecords.Records.Num() == 0)
 			{
-				for (int ChildIndex : CachedClassInfo.ChildIndicies)
+				return;
+			}
+
+			const int NumClasses = Classes.Num();
+			InstanceRecordStarts.SetNumZeroed(NumClasses + 1);
+			for (int32 ClassIndex : GatheredRecords.ClassIndices)
+			{
+				++InstanceRecordStarts[ClassIndex + 1];
+			}
+			for (int i = 1; i <= NumClasses; ++i)
+			{
+				InstanceRecordStarts[i] += InstanceRecordStarts[i - 1];
+			}
+
+			TArray<int32> ClassCursors(InstanceRecordStarts.GetData(), NumClasses);
+			InstanceRecords.SetNumUninitialized(GatheredRecords.Records.Num());
+			for (int32 i = 0; i < GatheredRecords.Records.Num(); ++i)
+			{
+				InstanceRecords[ClassCursors[GatheredRecords.ClassIndices[i]]++] = GatheredRecords.Records[i];
+			}
+			GatheredRecords.Empty();
+		}
+
+		// Records of instances attributed to exactly the class at ClassIndex.
+		TArrayView<const FInstanceRecord> GetInstanceRecords(int ClassIndex) const
+		{
+			if (!InstanceRecordStarts.IsValidIndex(ClassIndex + 1))
+			{
+				return TArrayView<const FInstanceRecord>();
+			}
+			return TArrayView<const FInstanceRecord>(InstanceRecords.GetData() + InstanceRecordStarts[ClassIndex], InstanceRecordStarts[ClassIndex + 1] - InstanceRecordStarts[ClassIndex]);
+		}
+
+		// Add the totals of every class into its parent. Super classes are always cached before their children, so a single
+		//	reverse pass over each column visits every child before its parent.
+		void RollupChildStats()
+		{
+			const int NumClasses = Classes.Num();
+			TArray<int> ParentIndices;
+			ParentIndices.SetNumUninitialized(NumClasses);
+			for (int i = 0; i < NumClasses; ++i)
+			{
+				ParentIndices[i] = Classes[i].ParentIndex;
+			}
+
+			for (int Col = 0; Col < EMemColumn::COUNT; ++Col)
+			{
+				uint64* ColumnBytes = TotalStats.Bytes[Col].GetData();
+				for (int i = NumClasses - 1; i >= 0; --i)
 				{
-					if (!DrawClassChildTreeIndex(ClassTree, ChildIndex, FilterZeroInstances, ClassNameFilter, ShowCols))
+					if (ParentIndices[i] != INDEX_NONE)
 					{
-						return false;
+						ColumnBytes[ParentIndices[i]] += ColumnBytes[i];
 					}
 				}
-				return true;
+			}
+
+			int* ColumnInstances = TotalStats.Instances.GetData();
+			for (int i = NumClasses - 1; i >= 0; --i)
+			{
+				if (ParentIndices[i] != INDEX_NONE)
+				{
+					ColumnInstances[ParentIndices[i]] += ColumnInstances[i];
+				}
 			}
 		}
 
-		static ImGuiTreeNodeFlags base_flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_AllowOverlap;
-		ImGuiTreeNodeFlags node_flags = base_flags;
-		if (CachedClassInfo.ChildIndicies.Num() == 0)
+		uint64 GetTotalBytes(int ClassIndex, EMemColumn::Type Column) const
 		{
-			node_flags |= ImGuiTreeNodeFlags_Leaf;
+			return TotalStats.Bytes[Column].IsValidIndex(ClassIndex) ? TotalStats.Bytes[Column][ClassIndex] : 0;
+		}
+
+		int GetTotalInstances(int ClassIndex) const
+		{
+			return TotalStats.Instances.IsValidIndex(ClassIndex) ? TotalStats.Instances[ClassIndex] : 0;
+		}
+
+		void SortByColumn(EMemColumn::Type Column)
+		{
+			for (FCachedClassInfo& ClassInfo : Classes)
+			{
+				ClassInfo.ChildIndicies.Sort([this, Column](int LHS, int RHS) { return GetTotalBytes(LHS, Column) > GetTotalBytes(RHS, Column); });
+			}
 		}
-		if (ClassNameFilter.IsActive() || (Index == ClassTree.RootIndex))
+
+		void SortBy(EMemSortType::Type InSortType)
 		{
-			node_flags |= ImGuiTreeNodeFlags_DefaultOpen;
+			SortType = InSortType;
+			++TreeVersion;
+			switch(SortType)
+			{
+				case EMemSortType::Alpha:
+					for (FCachedClassInfo& ClassInfo : Classes)
+					{
+						ClassInfo.ChildIndicies.Sort([this](int LHS, int RHS) { return GetNameSafe(Classes[LHS].Class.Get()) < GetNameSafe(Classes[RHS].Class.Get()); });
+					}
+					break;
+
+				case EMemSortType::Instances:
+					for (FCachedClassInfo& ClassInfo : Classes)
+					{
+						ClassInfo.ChildIndicies.Sort([this](int LHS, int RHS) { return GetTotalInstances(LHS) > GetTotalInstances(RHS); });
+					}
+					break;
+
+				case EMemSortType::TotalMem:		SortByColumn(EMemColumn::TotalMem); break;
+				case EMemSortType::UnknownMem:		SortByColumn(EMemColumn::UnknownMem); break;
+				case EMemSortType::DedSysMem:		SortByColumn(EMemColumn::DedSysMem); break;
+				case EMemSortType::DedVidMem:		SortByColumn(EMemColumn::DedVidMem); break;
+				case EMemSortType::SharedSysMem:	SortByColumn(EMemColumn::SharedSysMem); break;
+				case EMemSortType::SharedVidMem:	SortByColumn(EMemColumn::SharedVidMem); break;
+
+				default:
+					UE_LOG(LogImGuiDebugMem, Error, TEXT("FCachedClassTree::SortBy() - sorting with unimplemented type. not doing anything!"));
+					break;
+			}
 		}
 
-		const bool TreeOpen = ImGui::TreeNodeEx((void*)CachedClassInfo.Class.Get(), node_flags, "%s%s", Ansi(*CachedClassInfo.Class->GetName()), CachedClassInfo.bAbstract ? "(abstract)" : "");
-		ImGui::SameLine(ImGui::GetWindowWidth() - ((ShowCols.GetCachedShowColCount() + 1) * 110.0f) + 44.0f);
+		int RootIndex = INDEX_NONE;
+		TArray<FCachedClassInfo> Classes;
+		TMap<const UClass*, int> ClassToIndex;
+		uint64 CachedClassesVersion = 0;
+		int NumStaleEntries = 0;	// entries unlinked since the last rebuild or compaction
+
+		// Bumped whenever anything shown in the class tree changes (classes, stats or sorting), so views know to rebuild their rows.
+		uint32 TreeVersion = 0;
+		// Bumped when the class array is rebuilt from scratch and previous class indices are no longer meaningful.
+		uint32 ClassIndexGeneration = 0;
+		// Bumped every time a gather finishes, so anything built from the stats knows to rebuild.
+		uint32 StatsVersion = 0;
+
+		// Memory stats of the last gather, indexed by class index. SelfStats only count instances of exactly that class,
+		//	TotalStats include all child classes.
+		FMemColumns SelfStats;
+		FMemColumns TotalStats;
+
+		// Per-instance records of the last gather, grouped by class index, with per class offsets and a trailing end offset.
+		bool bKeepInstanceRecords = false;
+		bool bGatherKeepsRecords = false;	// bKeepInstanceRecords latched when the gather in progress started
+		TArray<FInstanceRecord> InstanceRecords;
+		TArray<int32> InstanceRecordStarts;
+		FInstanceRecordBuffer GatheredRecords;	// records of the gather in progress, in gather order
+
+		EMemSortType::Type SortType = EMemSortType::TotalMem;
+
+		// How long the last memory stats update took, for display. For time-sliced captures this is the wall time over all frames.
+		double LastUpdateDurationMs = 0.0;
+		EResourceSizeMode::Type SnapshotResourceSizeMode = EResourceSizeMode::Exclusive;
+
+		// Time-sliced capture state
+		float CaptureBudgetMs = 2.0f;
+		ECaptureState::Type CaptureState = ECaptureState::Idle;
+		std::atomic<int32> CaptureCursor { 0 };
+		bool CaptureIncludeCDO = false;
+		EResourceSizeMode::Type CaptureResourceSizeMode = EResourceSizeMode::Exclusive;
+		double CaptureStartTime = 0.0;
+		uint64 LastCaptureTickFrame = 0;
+		FMemColumns CaptureStats;
+		FCaptureListener CaptureListener;
+
+		// Classes touched behind the capture cursor, written from object create/delete listeners on any thread.
+		FCriticalSection DirtyClassesCS;
+		TSet<int> DirtyClassIndices;
+		bool bUnmappedClassDirty = false;
+		// Cached classes that received objects of classes loaded after the capture began.
+		TSet<int> UnmappedClassIndices;
+	};
+
+	///////////////////////////////////////
+	/////////  Live object counts
+	//	Optional create/delete listeners that keep per-class instance counts current between scans. The listeners run on whichever
+	//	thread creates or destroys the object, so counters live in a fixed size table keyed by class that is only ever touched with
+	//	atomics. Each object slot remembers which counter it was added to, so deletes never need to look at the (possibly already purged) class.
+	//	Classes are keyed by object index and serial number rather than by pointer, so a class allocated where a destroyed one used to be
+	//	never inherits its counter, and counters of destroyed classes are reclaimed after class deletions.
+
+	struct FLiveObjectCounter : public FUObjectArray::FUObjectCreateListener, public FUObjectArray::FUObjectDeleteListener
+	{
+		static constexpr int32 MaxClassCounters = 1 << 16;	// power of two, well above the number of classes in any project
+		static constexpr double RateInterval = 1.0;			// seconds between spawn/destroy rate samples
+		static constexpr uint64 EmptyKey = 0;				// serial numbers are never 0, so no class has this key
+		static constexpr uint64 ReclaimedKey = MAX_uint64;	// counter of a destroyed class, free to be claimed again
+		static constexpr int32 DefaultObjectSlotFlag = 1 << 30;	// set in ObjectCounterSlots for CDOs and their subobjects
+
+		struct FClassCounter
+		{
+			std::atomic<uint64> ClassKey { EmptyKey };
+			std::atomic<int32> Instances { 0 };
+			std::atomic<int32> DefaultObjects { 0 };	// instances that are class default objects or inside one
+			std::atomic<uint32> Spawned { 0 };
+			std::atomic<uint32> Destroyed { 0 };
+		};
 
-		if (ImGui::SmallButton(Ansi(*FString::Printf(TEXT("Inspect##%.54ls"), *CachedClassInfo.Class->GetName()))))
+		~FLiveObjectCounter()
 		{
-			FInstanceInspectorInfo& InstInfo = InstanceInspectors.AddDefaulted_GetRef();
-			InstInfo.Class = CachedClassInfo.Class;
+			Disable();
 		}
 
-		ImGui::NextColumn();
-		if (ShowCols.GetShowCol(EColumnTypes::Instances)) { ImGui::Text("%d", CachedClassInfo.Instances);ImGui::NextColumn(); }
-		if (ShowCols.GetShowCol(EColumnTypes::TotalMem)) { ImGui::Text("%.04f MB", CachedClassInfo.MemInfo.TotalMemoryMB); ImGui::NextColumn(); }
-		if (ShowCols.GetShowCol(EColumnTypes::UnknownMem)) { ImGui::Text("%.04f MB", CachedClassInfo.MemInfo.UnknownMemoryMB); ImGui::NextColumn(); }
-		if (ShowCols.GetShowCol(EColumnTypes::DedSysMem)) { ImGui::Text("%.04f MB", CachedClassInfo.MemInfo.DedSysMemoryMB); ImGui::NextColumn(); }
-		if (ShowCols.GetShowCol(EColumnTypes::DedVidMem)) { ImGui::Text("%.04f MB", CachedClassInfo.MemInfo.DedVidMemoryMB); ImGui::NextColumn(); }
-		if (ShowCols.GetShowCol(EColumnTypes::SharedSysMem)) { ImGui::Text("%.04f MB", CachedClassInfo.MemInfo.SharedSysMemoryMB); ImGui::NextColumn(); }
-		if (ShowCols.GetShowCol(EColumnTypes::SharedVidMem)) { ImGui::Text("%.04f MB", CachedClassInfo.MemInfo.SharedVidMemoryMB); ImGui::NextColumn(); }
-		ImGui::Separator();
+		bool IsEnabled() const
+		{
+			return bEnabled;
+		}
 
-		if (TreeOpen)
+		void Enable()
 		{
-			for (int ChildIndex : CachedClassInfo.ChildIndicies)
+			if (bEnabled)
+			{
+				return;
+			}
+
+			Counters = MakeUnique<FClassCounter[]>(MaxClassCounters);
+			NumObjectSlots = GUObjectArray.GetObjectArrayCapacity();
+			ObjectCounterSlots = MakeUnique<std::atomic<int32>[]>(NumObjectSlots);
+			CountedClassSlots = MakeUnique<std::atomic<uint8>[]>(NumObjectSlots);
+			for (int32 i = 0; i < NumObjectSlots; ++i)
+			{
+				ObjectCounterSlots[i].store(0, std::memory_order_relaxed);
+				CountedClassSlots[i].store(0, std::memory_order_relaxed);
+			}
+			NumCountedClassDeletions.store(0, std::memory_order_relaxed);
+			NewlyClaimedCounters.Reset();
+			ClaimedCounters.Reset();
+			bDeadCountersPending = false;
+			LastSpawned.SetNumZeroed(MaxClassCounters);
+			LastDestroyed.SetNumZeroed(MaxClassCounters);
+			SpawnRates.SetNumZeroed(MaxClassCounters);
+			DestroyRates.SetNumZeroed(MaxClassCounters);
+			LastRateSampleTime = FPlatformTime::Seconds();
+			TreeToCounter.Reset();
+			bEnabled = true;
+
+			GUObjectArray.AddUObjectCreateListener(this);
+			GUObjectArray.AddUObjectDeleteListener(this);
+
+			// Seed with the objects that already exist. Objects created on other threads meanwhile are only counted once, see CountObject().
+			const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+			for (int32 ObjectIndex = 0; ObjectIndex < NumObjects; ++ObjectIndex)
 			{
-				if (!DrawClassChildTreeIndex(ClassTree, ChildIndex, FilterZeroInstances, ClassNameFilter, ShowCols))
+				FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(ObjectIndex);
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+				const UObjectBase* Object = (ObjectItem != nullptr) ? ObjectItem->GetObject() : nullptr;
+#else	// ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+				const UObjectBase* Object = (ObjectItem != nullptr) ? ObjectItem->Object : nullptr;
+#endif	// ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+				if (Object != nullptr)
 				{
-					return false;
+					CountObject(Object, ObjectIndex, /*bSpawned*/ false);
 				}
 			}
-
-			ImGui::TreePop();
 		}
 
-		return true;
-	}
+		void Disable()
+		{
+			if (!bEnabled)
+			{
+				return;
+			}
 
-	void DrawHoveredItemInstanceTooltip(UObject* InstanceObject)
-	{
-		ImGui::BeginTooltip();
-		if (IsValid(InstanceObject))
+			// The shared tables are kept until the next Enable(), a listener call already in flight on another thread may still be using them.
+			bEnabled = false;
+			GUObjectArray.RemoveUObjectCreateListener(this);
+			GUObjectArray.RemoveUObjectDeleteListener(this);
+			LastSpawned.Empty();
+			LastDestroyed.Empty();
+			SpawnRates.Empty();
+			DestroyRates.Empty();
+			TreeToCounter.Empty();
+			ClaimedCounters.Empty();
+			ClassInstances.Empty();
+			ClassSpawnRates.Empty();
+			ClassDestroyRates.Empty();
+		}
+
+		// Object index and serial number of the class. Serial numbers are never reused, so the key is unique for the class' lifetime.
+		static uint64 GetClassKey(const UClass* Class, bool bAllocateSerial)
 		{
-			ImGui::Text("        Object: %s", Ansi(*GetNameSafe(InstanceObject)));
-			ImGui::Text("         Outer: %s", Ansi(*GetNameSafe(InstanceObject->GetOuter())));
-			ImGui::Text("default SubObj: %d", InstanceObject->IsDefaultSubobject());
+			const int32 ClassIndex = GUObjectArray.ObjectToIndex(Class);
+			const int32 SerialNumber = bAllocateSerial ? GUObjectArray.AllocateSerialNumber(ClassIndex) : GUObjectArray.IndexToObject(ClassIndex)->GetSerialNumber();
+			return (SerialNumber != 0) ? (((uint64)(uint32)ClassIndex << 32) | (uint32)SerialNumber) : EmptyKey;
 		}
-		else
+
+		// True while the class the key was made from still exists.
+		static bool IsClassKeyAlive(uint64 ClassKey)
 		{
-			ImGui::Text(" Invalid / Stale Object!");
+			const FUObjectItem* ClassItem = GUObjectArray.IndexToObject((int32)(ClassKey >> 32));
+			return (ClassItem != nullptr) && (ClassItem->GetSerialNumber() == (int32)(uint32)ClassKey);
+		}
+
+		// Find the counter of the class key. Lock free, safe to call from any thread. Reclaimed counters are probed past.
+		int32 FindCounter(uint64 ClassKey) const
+		{
+			uint32 Slot = GetTypeHash(ClassKey) & (MaxClassCounters - 1);
+			for (int32 Probe = 0; Probe < MaxClassCounters; ++Probe, Slot = (Slot + 1) & (MaxClassCounters - 1))
+			{
+				const uint64 SlotKey = Counters[Slot].ClassKey.load(std::memory_order_acquire);
+				if (SlotKey == ClassKey)
+				{
+					return Slot;
+				}
+				if (SlotKey == EmptyKey)
+				{
+					break;
+				}
+			}
+			return INDEX_NONE;
+		}
+
+		// Find the counter of the class key, claiming a free or reclaimed one if it has none yet. Claims only happen on the first
+		//	instance of a class, so they take a lock rather than racing other claims of the same slot.
+		int32 FindOrAddCounter(uint64 ClassKey)
+		{
+			const int32 FoundCounter = FindCounter(ClassKey);
+			if (FoundCounter != INDEX_NONE)
+			{
+				return FoundCounter;
+			}
+
+			FScopeLock Lock(&CounterClaimCS);
+			int32 FreeSlot = INDEX_NONE;
+			uint32 Slot = GetTypeHash(ClassKey) & (MaxClassCounters - 1);
+			for (int32 Probe = 0; Probe < MaxClassCounters; ++Probe, Slot = (Slot + 1) & (MaxClassCounters - 1))
+			{
+				const uint64 SlotKey = Counters[Slot].ClassKey.load(std::memory_order_acquire);
+				if (SlotKey == ClassKey)
+				{
+					return Slot;
+				}
+				if ((SlotKey == ReclaimedKey) && (FreeSlot == INDEX_NONE))
+				{
+					FreeSlot = Slot;
+				}
+				if (SlotKey == EmptyKey)
+				{
+					FreeSlot = (FreeSlot == INDEX_NONE) ? Slot : FreeSlot;
+					break;
+				}
+			}
+
+			if (FreeSlot != INDEX_NONE)
+			{
+				CountedClassSlots[(int32)(ClassKey >> 32)].store(1, std::memory_order_relaxed);
+				Counters[FreeSlot].ClassKey.store(ClassKey, std::memory_order_release);
+				NewlyClaimedCounters.Add(FreeSlot);
+			}
+			return FreeSlot;	// INDEX_NONE if the table is full, the class is not counted.
+		}
+
+		// Game thread: free the counters of destroyed classes once all of their instances are gone. Only the claimed counters are
+		//	visited, and only after a counted class was deleted. Reclaiming needs no lock: claims only take empty or reclaimed slots,
+		//	and a destroyed class' key never matches a class that is still being counted.
+		void ReclaimDeadCounters()
+		{
+			{
+				FScopeLock Lock(&CounterClaimCS);
+				ClaimedCounters.Append(NewlyClaimedCounters);
+				NewlyClaimedCounters.Reset();
+			}
+
+			if ((NumCountedClassDeletions.exchange(0, std::memory_order_relaxed) == 0) && !bDeadCountersPending)
+			{
+				return;
+			}
+
+			bDeadCountersPending = false;
+			for (int32 ClaimedIndex = ClaimedCounters.Num() - 1; ClaimedIndex >= 0; --ClaimedIndex)
+			{
+				const int32 i = ClaimedCounters[ClaimedIndex];
+				FClassCounter& Counter = Counters[i];
+				const uint64 ClassKey = Counter.ClassKey.load(std::memory_order_acquire);
+				if (IsClassKeyAlive(ClassKey))
+				{
+					// Deleted but not torn down yet, the delete listener runs before the slot's serial number is reset.
+					bDeadCountersPending |= (CountedClassSlots[(int32)(ClassKey >> 32)].load(std::memory_order_relaxed) == 0);
+					continue;
+				}
+				if (Counter.Instances.load(std::memory_order_relaxed) != 0)
+				{
+					bDeadCountersPending = true;	// instances of the destroyed class still around, look again next interval
+					continue;
+				}
+
+				Counter.DefaultObjects.store(0, std::memory_order_relaxed);
+				Counter.Spawned.store(0, std::memory_order_relaxed);
+				Counter.Destroyed.store(0, std::memory_order_relaxed);
+				LastSpawned[i] = 0;
+				LastDestroyed[i] = 0;
+				SpawnRates[i] = 0.0f;
+				DestroyRates[i] = 0.0f;
+				Counter.ClassKey.store(ReclaimedKey, std::memory_order_release);
+				ClaimedCounters.RemoveAtSwap(ClaimedIndex, 1, /*bAllowShrinking*/ false);
+			}
+		}
+
+		// Matches the IsTemplate(RF_ClassDefaultObject) test of the memory scans, on the object or any of its outers.
+		static bool IsDefaultObjectOrInside(const UObjectBase* Object)
+		{
+			for (const UObjectBase* Outer = Object; Outer != nullptr; Outer = Outer->GetOuter())
+			{
+				if ((Outer->GetFlags() & RF_ClassDefaultObject) != 0)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void CountObject(const UObjectBase* Object, int32 Index, bool bSpawned)
+		{
+			if ((Index < 0) || (Index >= NumObjectSlots))
+			{
+				return;
+			}
+
+			const int32 CounterIndex = FindOrAddCounter(GetClassKey(Object->GetClass(), /*bAllocateSerial*/ true));
+			if (CounterIndex == INDEX_NONE)
+			{
+				return;
+			}
+
+			// Slots store counter index + 1, with 0 meaning not counted. Whoever claims the slot first counts the object.
+			const bool bDefaultObject = IsDefaultObjectOrInside(Object);
+			int32 Expected = 0;
+			if (ObjectCounterSlots[Index].compare_exchange_strong(Expected, (CounterIndex + 1) | (bDefaultObject ? DefaultObjectSlotFlag : 0)))
+			{
+				FClassCounter& Counter = Counters[CounterIndex];
+				Counter.Instances.fetch_add(1, std::memory_order_relaxed);
+				if (bDefaultObject)
+				{
+					Counter.DefaultObjects.fetch_add(1, std::memory_order_relaxed);
+				}
+				if (bSpawned)
+				{
+					Counter.Spawned.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+		}
+
+		virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override
+		{
+			CountObject(Object, Index, /*bSpawned*/ true);
+		}
+
+		virtual void NotifyUObjectDeleted(const UObjectBase* Object, int32 Index) override
+		{
+			if ((Index < 0) || (Index >= NumObjectSlots))
+			{
+				return;
+			}
+
+			// Counted classes flag their own slot, so the reclaim scan only runs after one of them is deleted.
+			if ((CountedClassSlots[Index].load(std::memory_order_relaxed) != 0) && (CountedClassSlots[Index].exchange(0, std::memory_order_relaxed) != 0))
+			{
+				NumCountedClassDeletions.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			const int32 CounterSlot = ObjectCounterSlots[Index].exchange(0);
+			if (CounterSlot > 0)
+			{
+				FClassCounter& Counter = Counters[(CounterSlot & ~DefaultObjectSlotFlag) - 1];
+				Counter.Instances.fetch_sub(1, std::memory_order_relaxed);
+				if ((CounterSlot & DefaultObjectSlotFlag) != 0)
+				{
+					Counter.DefaultObjects.fetch_sub(1, std::memory_order_relaxed);
+				}
+				Counter.Destroyed.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		virtual void OnUObjectArrayShutdown() override
+		{
+			Disable();
+		}
+
+		// Game thread: sample spawn/destroy rates and refresh the per tree class totals (rolled up like the memory stats).
+		void UpdateClassTotals(const FCachedClassTree& ClassTree)
+		{
+			if (!bEnabled)
+			{
+				return;
+			}
+
+			const double Now = FPlatformTime::Seconds();
+			const double SampleDuration = Now - LastRateSampleTime;
+			if (SampleDuration >= RateInterval)
+			{
+				for (int32 i = 0; i < MaxClassCounters; ++i)
+				{
+					const uint32 Spawned = Counters[i].Spawned.load(std::memory_order_relaxed);
+					const uint32 Destroyed = Counters[i].Destroyed.load(std::memory_order_relaxed);
+					SpawnRates[i] = (float)((double)(Spawned - LastSpawned[i]) / SampleDuration);
+					DestroyRates[i] = (float)((double)(Destroyed - LastDestroyed[i]) / SampleDuration);
+					LastSpawned[i] = Spawned;
+					LastDestroyed[i] = Destroyed;
+				}
+				LastRateSampleTime = Now;
+				ReclaimDeadCounters();
+			}
+
+			const int NumClasses = ClassTree.Classes.Num();
+			if ((CachedClassIndexGeneration != ClassTree.ClassIndexGeneration) || (CachedIncludeCDO != bIncludeCDO))
+			{
+				TreeToCounter.Reset();
+				CachedClassIndexGeneration = ClassTree.ClassIndexGeneration;
+				CachedIncludeCDO = bIncludeCDO;
+			}
+			while (TreeToCounter.Num() < NumClasses)
+			{
+				TreeToCounter.Add(INDEX_NONE);
+			}
+
+			ClassInstances.SetNumUninitialized(NumClasses);
+			ClassSpawnRates.SetNumUninitialized(NumClasses);
+			ClassDestroyRates.SetNumUninitialized(NumClasses);
+			for (int i = 0; i < NumClasses; ++i)
+			{
+				// Classes only get a counter once their first instance is created, so keep looking until they have one. Destroyed
+				//	classes drop theirs, it may be reclaimed by another class.
+				const UClass* Class = ClassTree.Classes[i].Class.Get();
+				if (Class == nullptr)
+				{
+					TreeToCounter[i] = INDEX_NONE;
+				}
+				else if (TreeToCounter[i] == INDEX_NONE)
+				{
+					const uint64 ClassKey = GetClassKey(Class, /*bAllocateSerial*/ false);
+					TreeToCounter[i] = (ClassKey != EmptyKey) ? FindCounter(ClassKey) : INDEX_NONE;
+				}
+
+				const int32 CounterIndex = TreeToCounter[i];
+				const FClassCounter* Counter = (CounterIndex != INDEX_NONE) ? &Counters[CounterIndex] : nullptr;
+				ClassInstances[i] = (Counter != nullptr) ? (Counter->Instances.load(std::memory_order_relaxed) - (bIncludeCDO ? 0 : Counter->DefaultObjects.load(std::memory_order_relaxed))) : 0;
+				ClassSpawnRates[i] = (CounterIndex != INDEX_NONE) ? SpawnRates[CounterIndex] : 0.0f;
+				ClassDestroyRates[i] = (CounterIndex != INDEX_NONE) ? DestroyRates[CounterIndex] : 0.0f;
+			}
+			ClassSelfInstances = ClassInstances;
+
+			for (int i = NumClasses - 1; i >= 0; --i)
+			{
+				const int ParentIndex = ClassTree.Classes[i].ParentIndex;
+				if (ParentIndex != INDEX_NONE)
+				{
+					ClassInstances[ParentIndex] += ClassInstances[i];
+					ClassSpawnRates[ParentIndex] += ClassSpawnRates[i];
+					ClassDestroyRates[ParentIndex] += ClassDestroyRates[i];
+				}
+			}
+		}
+
+		bool HasClassTotals(int ClassIndex) const
+		{
+			return bEnabled && ClassInstances.IsValidIndex(ClassIndex);
+		}
+
+		// Shared between all threads
+		TUniquePtr<FClassCounter[]> Counters;
+		TUniquePtr<std::atomic<int32>[]> ObjectCounterSlots;
+		int32 NumObjectSlots = 0;
+		bool bEnabled = false;
+		TUniquePtr<std::atomic<uint8>[]> CountedClassSlots;	// per object slot, 1 while the class in it has a counter
+		std::atomic<uint32> NumCountedClassDeletions { 0 };
+		FCriticalSection CounterClaimCS;	// held while claiming a counter
+		TArray<int32> NewlyClaimedCounters;	// claimed since the last reclaim, guarded by CounterClaimCS
+
+		// Count class default objects (and objects inside them) like the memory scans do. Set from the Include CDO option.
+		bool bIncludeCDO = false;
+		bool CachedIncludeCDO = false;
+
+		// Game thread only
+		double LastRateSampleTime = 0.0;
+		TArray<uint32> LastSpawned;
+		TArray<uint32> LastDestroyed;
+		TArray<float> SpawnRates;
+		TArray<float> DestroyRates;
+		TArray<int32> TreeToCounter;
+		uint32 CachedClassIndexGeneration = 0;
+		TArray<int32> ClaimedCounters;	// counters holding a class key, live or destroyed
+		bool bDeadCountersPending = false;	// a destroyed class' counter could not be reclaimed yet
+
+		// Per tree class totals, including child classes, indexed by class index.
+		TArray<int32> ClassInstances;
+		TArray<int32> ClassSelfInstances;	// instances of exactly that class
+		TArray<float> ClassSpawnRates;
+		TArray<float> ClassDestroyRates;
+	};
+
+	FLiveObjectCounter LiveObjectCounter;
+
+	///////////////////////////////////////
+	/////////  Class Growth Tracking
+	///////////////////////////////////////
+
+	// Samples per-class instance counts from the live counters into ring buffers on an interval, plus total bytes for a small set of
+	//	watched classes, to spot classes that keep growing during long sessions. Game thread only.
+	struct FClassGrowthTracker
+	{
+		static constexpr int32 NumSamples = 64;	// ring buffer length per class
+		using FCountHistory = TRingHistory<int32, NumSamples>;
+		using FBytesHistory = TRingHistory<float, NumSamples>;
+
+		bool IsEnabled() const { return bEnabled; }
+
+		void SetEnabled(bool bInEnabled)
+		{
+			bEnabled = bInEnabled;
+			if (bEnabled && !LiveObjectCounter.IsEnabled())
+			{
+				LiveObjectCounter.Enable();	// counts come from the live counters, so tracking never rescans the object array
+			}
+		}
+
+		void Reset()
+		{
+			NumValidSamples = 0;
+			LastSampleTime = 0.0;
+			CountSamples.Reset();
+			Slopes.Reset();
+			LeakSuspects.Reset();
+			for (TPair<int, FBytesHistory>& Watched : WatchedBytes)
+			{
+				Watched.Value.Reset();
+			}
+		}
+
+		void Tick(const FCachedClassTree& ClassTree)
+		{
+			if (!bEnabled || !LiveObjectCounter.IsEnabled())
+			{
+				return;
+			}
+
+			if (CachedClassIndexGeneration != ClassTree.ClassIndexGeneration)
+			{
+				CachedClassIndexGeneration = ClassTree.ClassIndexGeneration;
+				WatchedBytes.Reset();
+				Reset();
+			}
+
+			const double Now = FPlatformTime::Seconds();
+			if ((Now - LastSampleTime) < SampleInterval)
+			{
+				return;
+			}
+			LastSampleTime = Now;
+
+			// Histories are per class, so classes added to the tree since the last sample only grow the array, and their history
+			//	starts with this sample.
+			const int NumClasses = FMath::Min(ClassTree.Classes.Num(), LiveObjectCounter.ClassSelfInstances.Num());
+			CountSamples.SetNum(NumClasses);
+			for (int i = 0; i < NumClasses; ++i)
+			{
+				CountSamples[i].Push(LiveObjectCounter.ClassSelfInstances[i]);
+			}
+
+			for (TPair<int, FBytesHistory>& Watched : WatchedBytes)
+			{
+				double TotalBytes = 0.0;
+				if (const UClass* Class = ClassTree.Classes.IsValidIndex(Watched.Key) ? ClassTree.Classes[Watched.Key].Class.Get() : nullptr)
+				{
+					::ForEachObjectOfClass(Class, [&TotalBytes](UObject* Object)
+					{
+						TotalBytes += (double)Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+					});
+				}
+				Watched.Value.Push((float)(TotalBytes / 1024.0 / 1024.0));
+			}
+
+			NumValidSamples = FMath::Min(NumValidSamples + 1, NumSamples);
+			UpdateLeakSuspects(NumClasses);
+		}
+
+		// Sample Age steps back from the newest one (Age 0).
+		int32 GetCountSample(int ClassIndex, int Age) const
+		{
+			return CountSamples[ClassIndex].Get(Age);
+		}
+
+		// Number of real samples the class has, which is less than NumValidSamples for classes first seen after sampling started.
+		int32 GetNumClassSamples(int ClassIndex) const
+		{
+			return CountSamples.IsValidIndex(ClassIndex) ? CountSamples[ClassIndex].Num() : 0;
+		}
+
+		bool HasSamples(int ClassIndex) const
+		{
+			return GetNumClassSamples(ClassIndex) > 0;
+		}
+
+		// Least squares slope of the counts over the leak window, in instances per minute. A class is a leak suspect once it has a full
+		//	window of real samples over which its count never went down and went up in at least MinGrowthSteps of the steps, so a
+		//	single step up is not enough.
+		void UpdateLeakSuspects(int NumClasses)
+		{
+			Slopes.SetNumZeroed(NumClasses);
+			LeakSuspects.Init(false, NumClasses);
+
+			const int32 RequiredGrowthSteps = FMath::Clamp(MinGrowthSteps, 1, LeakWindow - 1);
+			for (int i = 0; i < NumClasses; ++i)
+			{
+				const int32 Window = FMath::Min(LeakWindow, GetNumClassSamples(i));
+				if (Window < 3)
+				{
+					continue;
+				}
+
+				const double MeanX = (Window - 1) / 2.0;
+				double VarX = 0.0;
+				double CovXY = 0.0;
+				bool bMonotonic = true;
+				int32 GrowthSteps = 0;
+				for (int32 x = 0; x < Window; ++x)
+				{
+					const int32 Count = GetCountSample(i, Window - 1 - x);	// x = 0 is the oldest sample in the window
+					VarX += (x - MeanX) * (x - MeanX);
+					CovXY += (x - MeanX) * Count;
+					if (x > 0)
+					{
+						const int32 PrevCount = GetCountSample(i, Window - x);
+						bMonotonic &= (Count >= PrevCount);
+						GrowthSteps += (Count > PrevCount) ? 1 : 0;
+					}
+				}
+
+				Slopes[i] = (float)((CovXY / VarX) * (60.0 / SampleInterval));
+				LeakSuspects[i] = (Window >= LeakWindow) && bMonotonic && (GrowthSteps >= RequiredGrowthSteps);
+			}
+		}
+
+		bool IsLeakSuspect(int ClassIndex) const
+		{
+			return LeakSuspects.IsValidIndex(ClassIndex) && LeakSuspects[ClassIndex];
+		}
+
+		float GetSlope(int ClassIndex) const
+		{
+			return Slopes.IsValidIndex(ClassIndex) ? Slopes[ClassIndex] : 0.0f;
+		}
+
+		bool IsWatched(int ClassIndex) const
+		{
+			return WatchedBytes.Contains(ClassIndex);
+		}
+
+		void ToggleWatched(int ClassIndex)
+		{
+			if (WatchedBytes.Remove(ClassIndex) == 0)
+			{
+				WatchedBytes.Add(ClassIndex);
+			}
+		}
+
+		// Oldest to newest sparkline of the class' instance counts, red when it is a leak suspect.
+		void DrawCountSparkline(int ClassIndex, float Width) const
+		{
+			if (!HasSamples(ClassIndex))
+			{
+				return;
+			}
+
+			struct FPlotSource { const FClassGrowthTracker* Tracker; int ClassIndex; int NumClassSamples; };
+			FPlotSource Source = { this, ClassIndex, GetNumClassSamples(ClassIndex) };
+			const auto GetValue = [](void* Data, int Index) -> float
+			{
+				const FPlotSource& PlotSource = *static_cast<FPlotSource*>(Data);
+				return (float)PlotSource.Tracker->GetCountSample(PlotSource.ClassIndex, PlotSource.NumClassSamples - 1 - Index);
+			};
+
+			const bool bSuspect = IsLeakSuspect(ClassIndex);
+			if (bSuspect)
+			{
+				ImGui::PushStyleColor(ImGuiCol_PlotLines, ImVec4(1.0f, 0.3f, 0.3f, 1.0f));
+			}
+			ImGui::PushID(ClassIndex);
+			ImGui::PlotLines("##CountSparkline", GetValue, &Source, Source.NumClassSamples, 0, nullptr, FLT_MAX, FLT_MAX, ImVec2(Width, ImGui::GetTextLineHeight()));
+			ImGui::PopID();
+			if (bSuspect)
+			{
+				ImGui::PopStyleColor();
+			}
+		}
+
+		void DrawBytesSparkline(int ClassIndex, float Width) const
+		{
+			const FBytesHistory* Samples = WatchedBytes.Find(ClassIndex);
+			if ((Samples == nullptr) || (Samples->Num() == 0))
+			{
+				return;
+			}
+
+			ImGui::PushID(ClassIndex);
+			ImGui::PlotLines("##BytesSparkline", Samples->GetData(), Samples->Num(), Samples->GetOldestOffset(), nullptr, FLT_MAX, FLT_MAX, ImVec2(Width, ImGui::GetTextLineHeight() * 2.0f));
+			ImGui::PopID();
+		}
+
+		bool bEnabled = false;
+		float SampleInterval = 10.0f;	// seconds between samples
+		int32 LeakWindow = 12;			// samples a count must keep growing over to be flagged
+		int32 MinGrowthSteps = 4;		// steps within the window that must strictly increase to be flagged
+		double LastSampleTime = 0.0;
+		int32 NumValidSamples = 0;		// samples taken since the last reset, capped to NumSamples
+		uint32 CachedClassIndexGeneration = 0;
+
+		TArray<FCountHistory> CountSamples;	// per class index
+		TArray<float> Slopes;
+		TBitArray<> LeakSuspects;
+		TMap<int, FBytesHistory> WatchedBytes;	// class index -> MB history, starting when the class was watched
+	};
+
+	FClassGrowthTracker ClassGrowthTracker;
+
+	///////////////////////////////////////
+	/////////  Object Memory Snapshots
+	//	Saved to Saved/ImGuiTools/ as a small versioned binary: a header, a fixed size record per class, then a blob of UTF-8 class paths.
+	//	Records hold exact class stats (not rolled up), so a snapshot diff never double counts a class through its parents.
+
+	static constexpr uint32 MemSnapshotMagic = 0x534D4749;	// 'IGMS'
+	static constexpr uint32 MemSnapshotVersion = 1;
+	static const TCHAR* MemSnapshotExtension = TEXT(".igmemsnap");
+
+	struct FMemSnapshotFileHeader
+	{
+		uint32 Magic = MemSnapshotMagic;
+		uint32 Version = MemSnapshotVersion;
+		int64 TimestampTicks = 0;
+		uint32 ResourceSizeMode = 0;
+		uint32 NumEntries = 0;
+		uint32 LabelOffset = 0;
+		uint32 LabelLength = 0;
+		uint32 StringBlobSize = 0;
+		uint32 Padding = 0;
+	};
+	static_assert(sizeof(FMemSnapshotFileHeader) == 40, "FMemSnapshotFileHeader layout is part of the snapshot file format, bump MemSnapshotVersion when changing it.");
+
+	struct FMemSnapshotFileEntry
+	{
+		uint32 PathOffset = 0;
+		uint32 PathLength = 0;
+		int32 Instances = 0;
+		uint32 Padding = 0;
+		uint64 Bytes[EMemColumn::COUNT] = {};
+	};
+	static_assert(sizeof(FMemSnapshotFileEntry) == 64, "FMemSnapshotFileEntry layout is part of the snapshot file format, bump MemSnapshotVersion when changing it.");
+
+	struct FMemSnapshotEntry
+	{
+		FString ClassPath;
+		int Instances = 0;
+		uint64 Bytes[EMemColumn::COUNT] = {};
+	};
+
+	struct FMemSnapshot
+	{
+		FString Label;
+		FDateTime Timestamp;
+		EResourceSizeMode::Type ResourceSizeMode = EResourceSizeMode::Exclusive;
+		TArray<FMemSnapshotEntry> Entries;
+
+		static FString GetSnapshotDir()
+		{
+			return FPaths::ProjectSavedDir() / TEXT("ImGuiTools");
+		}
+
+		// Build a snapshot from the exact class stats of the last gather in the class tree.
+		void CaptureFromClassTree(const FCachedClassTree& ClassTree, const FString& InLabel)
+		{
+			Label = InLabel;
+			Timestamp = FDateTime::UtcNow();
+			ResourceSizeMode = ClassTree.SnapshotResourceSizeMode;
+			Entries.Reset();
+			const FMemColumns& SelfStats = ClassTree.SelfStats;
+			for (int ClassIndex = 0; ClassIndex < SelfStats.Num(); ++ClassIndex)
+			{
+				const UClass* Class = ClassTree.Classes[ClassIndex].Class.Get();
+				if ((Class == nullptr) || (SelfStats.Instances[ClassIndex] == 0))
+				{
+					continue;
+				}
+
+				FMemSnapshotEntry& Entry = Entries.AddDefaulted_GetRef();
+				Entry.ClassPath = Class->GetPathName();
+				Entry.Instances = SelfStats.Instances[ClassIndex];
+				for (int Col = 0; Col < EMemColumn::COUNT; ++Col)
+				{
+					Entry.Bytes[Col] = SelfStats.Bytes[Col][ClassIndex];
+				}
+			}
+		}
+
+		bool SaveToFile(const FString& FilePath) const
+		{
+			TArray<uint8> StringBlob;
+			const auto AppendString = [&StringBlob](const FString& String, uint32& OutOffset, uint32& OutLength)
+			{
+				OutOffset = StringBlob.Num();
+				OutLength = AppendUtf8(StringBlob, *String);
+			};
+
+			FMemSnapshotFileHeader Header;
+			Header.TimestampTicks = Timestamp.GetTicks();
+			Header.ResourceSizeMode = static_cast<uint32>(ResourceSizeMode);
+			Header.NumEntries = Entries.Num();
+			AppendString(Label, Header.LabelOffset, Header.LabelLength);
+
+			TArray<FMemSnapshotFileEntry> FileEntries;
+			FileEntries.SetNum(Entries.Num());
+			for (int i = 0; i < Entries.Num(); ++i)
+			{
+				FMemSnapshotFileEntry& FileEntry = FileEntries[i];
+				AppendString(Entries[i].ClassPath, FileEntry.PathOffset, FileEntry.PathLength);
+				FileEntry.Instances = Entries[i].Instances;
+				FMemory::Memcpy(FileEntry.Bytes, Entries[i].Bytes, sizeof(FileEntry.Bytes));
+			}
+			Header.StringBlobSize = StringBlob.Num();
+
+			TArray<uint8> FileData;
+			FileData.Reserve(sizeof(Header) + FileEntries.Num() * sizeof(FMemSnapshotFileEntry) + StringBlob.Num());
+			FileData.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+			FileData.Append(reinterpret_cast<const uint8*>(FileEntries.GetData()), FileEntries.Num() * sizeof(FMemSnapshotFileEntry));
+			FileData.Append(StringBlob);
+
+			return FFileHelper::SaveArrayToFile(FileData, *FilePath);
+		}
+
+		// Load a snapshot through a memory mapped view of the file. Records are read straight out of the mapping.
+		bool LoadFromFile(const FString& FilePath)
+		{
+			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+			TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*FilePath));
+			if (!MappedFile.IsValid())
+			{
+				UE_LOG(LogImGuiDebugMem, Warning, TEXT("FMemSnapshot::LoadFromFile() - unable to map '%s'."), *FilePath);
+				return false;
+			}
+
+			const int64 FileSize = MappedFile->GetFileSize();
+			if (FileSize < (int64)sizeof(FMemSnapshotFileHeader))
+			{
+				UE_LOG(LogImGuiDebugMem, Warning, TEXT("FMemSnapshot::LoadFromFile() - '%s' is too small to be a snapshot."), *FilePath);
+				return false;
+			}
+
+			TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile->MapRegion(0, FileSize));
+			if (!MappedRegion.IsValid())
+			{
+				UE_LOG(LogImGuiDebugMem, Warning, TEXT("FMemSnapshot::LoadFromFile() - unable to map a view of '%s'."), *FilePath);
+				return false;
+			}
+
+			const uint8* FileData = MappedRegion->GetMappedPtr();
+			FMemSnapshotFileHeader Header;
+			FMemory::Memcpy(&Header, FileData, sizeof(Header));
+			const int64 EntriesSize = (int64)Header.NumEntries * sizeof(FMemSnapshotFileEntry);
+			if ((Header.Magic != MemSnapshotMagic) || (Header.Version != MemSnapshotVersion) || (FileSize != (int64)sizeof(Header) + EntriesSize + Header.StringBlobSize))
+			{
+				UE_LOG(LogImGuiDebugMem, Warning, TEXT("FMemSnapshot::LoadFromFile() - '%s' is not a valid version %u snapshot."), *FilePath, MemSnapshotVersion);
+				return false;
+			}
+
+			const uint8* FileEntries = FileData + sizeof(Header);
+			const ANSICHAR* StringBlob = reinterpret_cast<const ANSICHAR*>(FileEntries + EntriesSize);
+			const auto ReadString = [StringBlob, &Header](uint32 Offset, uint32 Length)
+			{
+				if (((uint64)Offset + Length) > Header.StringBlobSize)
+				{
+					return FString();
+				}
+				FUTF8ToTCHAR TCHARString(StringBlob + Offset, Length);
+				return FString(TCHARString.Length(), TCHARString.Get());
+			};
+
+			Label = ReadString(Header.LabelOffset, Header.LabelLength);
+			Timestamp = FDateTime(Header.TimestampTicks);
+			ResourceSizeMode = static_cast<EResourceSizeMode::Type>(Header.ResourceSizeMode);
+			Entries.SetNum(Header.NumEntries);
+			for (uint32 i = 0; i < Header.NumEntries; ++i)
+			{
+				FMemSnapshotFileEntry FileEntry;
+				FMemory::Memcpy(&FileEntry, FileEntries + (i * sizeof(FMemSnapshotFileEntry)), sizeof(FileEntry));
+
+				FMemSnapshotEntry& Entry = Entries[i];
+				Entry.ClassPath = ReadString(FileEntry.PathOffset, FileEntry.PathLength);
+				Entry.Instances = FileEntry.Instances;
+				FMemory::Memcpy(Entry.Bytes, FileEntry.Bytes, sizeof(Entry.Bytes));
+			}
+
+			return true;
+		}
+	};
+
+	// A per-class difference between two snapshots, B - A.
+	struct FMemSnapshotDiffRow
+	{
+		FString ClassPath;
+		FString ClassName;
+		int InstancesA = 0;
+		int InstancesB = 0;
+		int64 DeltaBytes[EMemColumn::COUNT] = {};
+		TArray<ANSICHAR> Utf8ClassName;	// for drawing and filtering without converting every frame
+
+		int GetDeltaInstances() const { return InstancesB - InstancesA; }
+		const ANSICHAR* GetUtf8ClassName() const { return Utf8ClassName.GetData(); }
+	};
+
+	// Lists saved snapshots, holds the two snapshots being compared and their diff.
+	struct FMemSnapshotBrowser
+	{
+		// Snapshots are selected by file name, so refreshing the file list never changes what is being compared. The empty name
+		//	selects the live class tree stats.
+		static bool IsCurrentSelection(const FString& Selection) { return Selection.IsEmpty(); }
+
+		TArray<FString> SnapshotFiles;
+		FString SelectionA;
+		FString SelectionB;
+		bool bSelectionInitialized = false;
+		bool bDiffMode = false;
+
+		FMemSnapshot SnapshotA;
+		FMemSnapshot SnapshotB;
+		TArray<FMemSnapshotDiffRow> DiffRows;
+		EMemSortType::Type DiffSortType = EMemSortType::None;
+		bool bResourceSizeModeMismatch = false;	// A and B were captured with different resource size modes, so there are no rows
+		uint32 CurrentStatsVersion = 0;			// class tree StatsVersion a Current side was captured from
+
+		// DiffRows passing the class name filter, in sort order, drawn through a clipper.
+		TArray<int32> VisibleRows;
+		bool bVisibleRowsDirty = true;
+
+		static const TCHAR* GetResourceSizeModeName(EResourceSizeMode::Type Mode)
+		{
+			return (Mode == EResourceSizeMode::EstimatedTotal) ? TEXT("Estimated Total") : TEXT("Exclusive");
+		}
+
+		void RefreshFileList()
+		{
+			SnapshotFiles.Reset();
+			IFileManager::Get().FindFiles(SnapshotFiles, *(FMemSnapshot::GetSnapshotDir() / (FString(TEXT("*")) + MemSnapshotExtension)), /*Files*/ true, /*Directories*/ false);
+			SnapshotFiles.Sort([](const FString& LHS, const FString& RHS) { return LHS > RHS; });	// newest first, file names start with a timestamp
+
+			// Default to comparing the newest saved snapshot against the current stats, and fall back to the current stats for
+			//	snapshots that have been deleted.
+			if (!bSelectionInitialized && (SnapshotFiles.Num() > 0))
+			{
+				SelectionA = SnapshotFiles[0];
+				bSelectionInitialized = true;
+			}
+			if (!IsCurrentSelection(SelectionA) && !SnapshotFiles.Contains(SelectionA))
+			{
+				SelectionA.Reset();
+			}
+			if (!IsCurrentSelection(SelectionB) && !SnapshotFiles.Contains(SelectionB))
+			{
+				SelectionB.Reset();
+			}
+		}
+
+		bool SaveCurrent(const FCachedClassTree& ClassTree, const FString& Label)
+		{
+			FMemSnapshot Snapshot;
+			Snapshot.CaptureFromClassTree(ClassTree, Label);
+
+			const FString FileName = FString::Printf(TEXT("%s_%s%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")), *FPaths::MakeValidFileName(Label), MemSnapshotExtension);
+			const bool bSaved = Snapshot.SaveToFile(FMemSnapshot::GetSnapshotDir() / FileName);
+			RefreshFileList();
+			return bSaved;
+		}
+
+		bool LoadSelection(const FString& Selection, const FCachedClassTree& ClassTree, FMemSnapshot& OutSnapshot) const
+		{
+			if (IsCurrentSelection(Selection))
+			{
+				OutSnapshot.CaptureFromClassTree(ClassTree, TEXT("Current"));
+				return true;
+			}
+			return OutSnapshot.LoadFromFile(FMemSnapshot::GetSnapshotDir() / Selection);
+		}
+
+		// True when a side of the diff shows the current stats and a gather has finished since it was built.
+		bool IsCurrentSideStale(const FCachedClassTree& ClassTree) const
+		{
+			return bDiffMode && (IsCurrentSelection(SelectionA) || IsCurrentSelection(SelectionB)) && (CurrentStatsVersion != ClassTree.StatsVersion);
+		}
+
+		void RebuildDiff(const FCachedClassTree& ClassTree)
+		{
+			DiffRows.Reset();
+			DiffSortType = EMemSortType::None;
+			bResourceSizeModeMismatch = false;
+			bVisibleRowsDirty = true;
+			CurrentStatsVersion = ClassTree.StatsVersion;
+			if (!LoadSelection(SelectionA, ClassTree, SnapshotA) || !LoadSelection(SelectionB, ClassTree, SnapshotB))
+			{
+				return;
+			}
+
+			// Exclusive and estimated total sizes are not comparable, the diff would mostly show the difference between the modes.
+			if (SnapshotA.ResourceSizeMode != SnapshotB.ResourceSizeMode)
+			{
+				bResourceSizeModeMismatch = true;
+				return;
+			}
+
+			TMap<FString, int> PathToRow;
+			const auto AddSnapshotRows = [this, &PathToRow](const FMemSnapshot& Snapshot, bool bIsA)
+			{
+				for (const FMemSnapshotEntry& Entry : Snapshot.Entries)
+				{
+					int& RowIndex = PathToRow.FindOrAdd(Entry.ClassPath, INDEX_NONE);
+					if (RowIndex == INDEX_NONE)
+					{
+						RowIndex = DiffRows.Num();
+						FMemSnapshotDiffRow& NewRow = DiffRows.AddDefaulted_GetRef();
+						NewRow.ClassPath = Entry.ClassPath;
+						NewRow.ClassName = FPackageName::ObjectPathToObjectName(Entry.ClassPath);
+						CopyUtf8(NewRow.Utf8ClassName, NewRow.ClassName);
+					}
+
+					FMemSnapshotDiffRow& Row = DiffRows[RowIndex];
+					(bIsA ? Row.InstancesA : Row.InstancesB) += Entry.Instances;
+					for (int Col = 0; Col < EMemColumn::COUNT; ++Col)
+					{
+						Row.DeltaBytes[Col] += bIsA ? -(int64)Entry.Bytes[Col] : (int64)Entry.Bytes[Col];
+					}
+				}
+			};
+			AddSnapshotRows(SnapshotA, /*bIsA*/ true);
+			AddSnapshotRows(SnapshotB, /*bIsA*/ false);
+		}
+
+		// Sort rows by delta, largest growth first.
+		void SortDiff(EMemSortType::Type SortType)
+		{
+			DiffSortType = SortType;
+			bVisibleRowsDirty = true;
+			const auto SortByColumn = [this](EMemColumn::Type Column)
+			{
+				DiffRows.Sort([Column](const FMemSnapshotDiffRow& LHS, const FMemSnapshotDiffRow& RHS) { return LHS.DeltaBytes[Column] > RHS.DeltaBytes[Column]; });
+			};
+
+			switch (SortType)
+			{
+				case EMemSortType::Alpha:			DiffRows.Sort([](const FMemSnapshotDiffRow& LHS, const FMemSnapshotDiffRow& RHS) { return LHS.ClassName < RHS.ClassName; }); break;
+				case EMemSortType::Instances:		DiffRows.Sort([](const FMemSnapshotDiffRow& LHS, const FMemSnapshotDiffRow& RHS) { return LHS.GetDeltaInstances() > RHS.GetDeltaInstances(); }); break;
+				case EMemSortType::TotalMem:		SortByColumn(EMemColumn::TotalMem); break;
+				case EMemSortType::UnknownMem:		SortByColumn(EMemColumn::UnknownMem); break;
+				case EMemSortType::DedSysMem:		SortByColumn(EMemColumn::DedSysMem); break;
+				case EMemSortType::DedVidMem:		SortByColumn(EMemColumn::DedVidMem); break;
+				case EMemSortType::SharedSysMem:	SortByColumn(EMemColumn::SharedSysMem); break;
+				case EMemSortType::SharedVidMem:	SortByColumn(EMemColumn::SharedVidMem); break;
+				default: break;
+			}
+		}
+
+		void UpdateVisibleRows(const ImGuiTextFilter& ClassNameFilter)
+		{
+			if (!bVisibleRowsDirty)
+			{
+				return;
+			}
+
+			bVisibleRowsDirty = false;
+			VisibleRows.Reset(DiffRows.Num());
+			for (int32 i = 0; i < DiffRows.Num(); ++i)
+			{
+				if (!ClassNameFilter.IsActive() || ClassNameFilter.PassFilter(DiffRows[i].GetUtf8ClassName()))
+				{
+					VisibleRows.Add(i);
+				}
+			}
+		}
+
+		FString GetSelectionName(const FString& Selection) const
+		{
+			return IsCurrentSelection(Selection) ? FString(TEXT("Current")) : Selection;
+		}
+	};
+
+	FMemSnapshotBrowser SnapshotBrowser;
+
+	void DrawSnapshotControls(FCachedClassTree& ClassTree)
+	{
+		static bool bFileListCached = false;
+		if (!bFileListCached)
+		{
+			SnapshotBrowser.RefreshFileList();
+			bFileListCached = true;
+		}
+
+		static char SnapshotLabel[64] = "";
+		ImGui::SetNextItemWidth(200.0f);
+		ImGui::InputText("Label", SnapshotLabel, UE_ARRAY_COUNT(SnapshotLabel));
+		ImGui::SameLine();
+		if (ImGui::Button("Save Snapshot"))
+		{
+			const FString Label = (SnapshotLabel[0] != '\0') ? FString(UTF8_TO_TCHAR(SnapshotLabel)) : FApp::GetBuildVersion();
+			SnapshotBrowser.SaveCurrent(ClassTree, Label);
+		}
+		ImGui::SameLine();
+		bool bSelectionChanged = false;
+		if (ImGui::SmallButton("Refresh List"))
+		{
+			const FString PrevSelectionA = SnapshotBrowser.SelectionA;
+			const FString PrevSelectionB = SnapshotBrowser.SelectionB;
+			SnapshotBrowser.RefreshFileList();
+			bSelectionChanged = (PrevSelectionA != SnapshotBrowser.SelectionA) || (PrevSelectionB != SnapshotBrowser.SelectionB);
+		}
+		ImGui::SameLine();
+		bSelectionChanged |= ImGui::Checkbox("Diff Mode (B - A)", &SnapshotBrowser.bDiffMode);
+
+		ImGui::BeginChild("SnapshotList", ImVec2(0, 100.0f), true);
+		const auto DrawSelectionRow = [&bSelectionChanged](const FString& Selection)
+		{
+			ImGui::PushID(Ansi(*SnapshotBrowser.GetSelectionName(Selection)));
+			if (ImGui::RadioButton("A", SnapshotBrowser.SelectionA == Selection)) { SnapshotBrowser.SelectionA = Selection; bSelectionChanged = true; }
+			ImGui::SameLine();
+			if (ImGui::RadioButton("B", SnapshotBrowser.SelectionB == Selection)) { SnapshotBrowser.SelectionB = Selection; bSelectionChanged = true; }
+			ImGui::SameLine();
+			ImGui::Text("%s", Ansi(*SnapshotBrowser.GetSelectionName(Selection)));
+			ImGui::PopID();
+		};
+		DrawSelectionRow(FString());
+		for (const FString& SnapshotFile : SnapshotBrowser.SnapshotFiles)
+		{
+			DrawSelectionRow(SnapshotFile);
+		}
+		ImGui::EndChild(); // "SnapshotList"
+
+		if ((bSelectionChanged && SnapshotBrowser.bDiffMode) || SnapshotBrowser.IsCurrentSideStale(ClassTree))
+		{
+			SnapshotBrowser.RebuildDiff(ClassTree);
+		}
+
+		if (SnapshotBrowser.bDiffMode && SnapshotBrowser.bResourceSizeModeMismatch)
+		{
+			ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Not comparable: A was captured as %s and B as %s. Pick snapshots captured with the same resource size mode.",
+				Ansi(FMemSnapshotBrowser::GetResourceSizeModeName(SnapshotBrowser.SnapshotA.ResourceSizeMode)),
+				Ansi(FMemSnapshotBrowser::GetResourceSizeModeName(SnapshotBrowser.SnapshotB.ResourceSizeMode)));
+		}
+	}
+
+	void DrawSnapshotDiff(EMemSortType::Type SortType, ImGuiTextFilter& ClassNameFilter, ImGuiTools::Utils::FShowCols& ShowCols)
+	{
+		if (SnapshotBrowser.DiffSortType != SortType)
+		{
+			SnapshotBrowser.SortDiff(SortType);
+		}
+		SnapshotBrowser.UpdateVisibleRows(ClassNameFilter);
+
+		ImGuiListClipper Clipper;
+		Clipper.Begin(SnapshotBrowser.VisibleRows.Num());
+		while (Clipper.Step())
+		{
+			for (int32 VisibleIndex = Clipper.DisplayStart; VisibleIndex < Clipper.DisplayEnd; ++VisibleIndex)
+			{
+				const FMemSnapshotDiffRow& Row = SnapshotBrowser.DiffRows[SnapshotBrowser.VisibleRows[VisibleIndex]];
+				ImGui::TextUnformatted(Row.GetUtf8ClassName());
+				if (ImGui::IsItemHovered())
+				{
+					ImGui::SetTooltip("%s", Ansi(*Row.ClassPath));
+				}
+				ImGui::NextColumn();
+				if (ShowCols.GetShowCol(EColumnTypes::Instances)) { ImGui::Text("%+d (%d->%d)", Row.GetDeltaInstances(), Row.InstancesA, Row.InstancesB); ImGui::NextColumn(); }
+				if (ShowCols.GetShowCol(EColumnTypes::TotalMem)) { ImGui::Text("%+.04f MB", (double)Row.DeltaBytes[EMemColumn::TotalMem] / 1024.0 / 1024.0); ImGui::NextColumn(); }
+				if (ShowCols.GetShowCol(EColumnTypes::UnknownMem)) { ImGui::Text("%+.04f MB", (double)Row.DeltaBytes[EMemColumn::UnknownMem] / 1024.0 / 1024.0); ImGui::NextColumn(); }
+				if (ShowCols.GetShowCol(EColumnTypes::DedSysMem)) { ImGui::Text("%+.04f MB", (double)Row.DeltaBytes[EMemColumn::DedSysMem] / 1024.0 / 1024.0); ImGui::NextColumn(); }
+				if (ShowCols.GetShowCol(EColumnTypes::DedVidMem)) { ImGui::Text("%+.04f MB", (double)Row.DeltaBytes[EMemColumn::DedVidMem] / 1024.0 / 1024.0); ImGui::NextColumn(); }
+				if (ShowCols.GetShowCol(EColumnTypes::SharedSysMem)) { ImGui::Text("%+.04f MB", (double)Row.DeltaBytes[EMemColumn::SharedSysMem] / 1024.0 / 1024.0); ImGui::NextColumn(); }
+				if (ShowCols.GetShowCol(EColumnTypes::SharedVidMem)) { ImGui::Text("%+.04f MB", (double)Row.DeltaBytes[EMemColumn::SharedVidMem] / 1024.0 / 1024.0); ImGui::NextColumn(); }
+				if (ShowCols.GetShowCol(EColumnTypes::RetainedMem)) { ImGui::NextColumn(); }	// snapshots do not record retained sizes
+				if (ShowCols.GetShowCol(EColumnTypes::Growth)) { ImGui::NextColumn(); }
+				ImGui::Separator();
+			}
+		}
+	}
+
+	// All live objects grouped by exact class, shared by every open instance inspector so any number of inspectors refreshing on
+	//	the same frame cost a single walk of the object array. Holds raw pointers, so it is only valid for the frame it was built on.
+	struct FObjectClassBuckets
+	{
+		void RefreshForFrame()
+		{
+			if (BuiltFrame == GFrameCounter)
+			{
+				return;
+			}
+			BuiltFrame = GFrameCounter;
+
+			// Keep the per-bucket allocations around between refreshes, only the class lookup is rebuilt.
+			ClassToBucket.Reset();
+			BucketClasses.Reset();
+			for (TArray<UObject*>& Bucket : Buckets)
+			{
+				Bucket.Reset();
+			}
+
+			// Objects of the same class tend to sit next to each other in the object array, so remember the last lookup.
+			const UClass* LastClass = nullptr;
+			TArray<UObject*>* LastBucket = nullptr;
+			for (FThreadSafeObjectIterator It; It; ++It)
+			{
+				const UClass* ObjectClass = It->GetClass();
+				if (ObjectClass != LastClass)
+				{
+					LastClass = ObjectClass;
+					const int32* FoundBucket = ClassToBucket.Find(ObjectClass);
+					int32 BucketIndex = (FoundBucket != nullptr) ? *FoundBucket : INDEX_NONE;
+					if (BucketIndex == INDEX_NONE)
+					{
+						BucketIndex = BucketClasses.Add(ObjectClass);
+						ClassToBucket.Add(ObjectClass, BucketIndex);
+						if (Buckets.Num() <= BucketIndex)
+						{
+							Buckets.SetNum(BucketIndex + 1);
+						}
+					}
+					LastBucket = &Buckets[BucketIndex];
+				}
+				LastBucket->Add(*It);
+			}
+		}
+
+		// Call Func for every object of the class or any of its child classes. RefreshForFrame() must have been called this frame.
+		template<typename FuncType>
+		void ForEachObjectOfClass(const UClass* Class, FuncType Func) const
+		{
+			check(BuiltFrame == GFrameCounter);
+			for (int32 BucketIndex = 0; BucketIndex < BucketClasses.Num(); ++BucketIndex)
+			{
+				if (!BucketClasses[BucketIndex]->IsChildOf(Class))
+				{
+					continue;
+				}
+
+				for (UObject* Object : Buckets[BucketIndex])
+				{
+					Func(Object);
+				}
+			}
+		}
+
+		TMap<const UClass*, int32> ClassToBucket;
+		TArray<const UClass*> BucketClasses;
+		TArray<TArray<UObject*>> Buckets;	// objects per entry of BucketClasses. May hold more (empty) buckets than there are classes.
+		uint64 BuiltFrame = MAX_uint64;
+	};
+
+	FObjectClassBuckets ObjectClassBuckets;
+
+	// Struct for each instance in the list of all instances per-class
+	struct FInstanceInspectorInstanceInfo
+	{
+		TWeakObjectPtr<UObject> InstanceWkPtr = nullptr;
+		FMemInfo MemInfo;
+
+		// Cached when the instance is gathered so drawing and filtering the list never touch the object.
+		TArray<ANSICHAR> Utf8Name;
+		TArray<ANSICHAR> Utf8OuterName;
+		bool bDefaultSubobject = false;
+
+		const ANSICHAR* GetUtf8Name() const { return Utf8Name.GetData(); }
+		const ANSICHAR* GetUtf8OuterName() const { return Utf8OuterName.GetData(); }
+
+		void CacheNames(const UObject* Object)
+		{
+			CopyUtf8(Utf8Name, GetNameSafe(Object));
+			CopyUtf8(Utf8OuterName, GetNameSafe((Object != nullptr) ? Object->GetOuter() : nullptr));
+			bDefaultSubobject = (Object != nullptr) && Object->IsDefaultSubobject();
+		}
+	};
+
+	namespace EInstanceGrouping
+	{
+		enum Type
+		{
+			None = 0,
+			OutermostPackage,
+			Outer,
+			World,
+			ContentFolder,
+		};
+	}	// namespace EInstanceGrouping
+
+	// Instances aggregated by package, outer, world or content folder, with one level of sub rows per group (classes or instances).
+	//	Built with a single hash aggregation pass over captured instances, game thread only.
+	struct FInstanceGroupTree
+	{
+		struct FRow
+		{
+			TArray<ANSICHAR> Utf8Label;
+			double TotalMemoryMB = 0.0;
+			int Instances = 0;
+			int32 SubKey = INDEX_NONE;	// caller defined, e.g. class or instance index
+
+			const ANSICHAR* GetUtf8Label() const { return Utf8Label.GetData(); }
+		};
+
+		struct FGroup : public FRow
+		{
+			TArray<FRow> SubRows;
+			TMap<int32, int32> SubKeyToRow;
+		};
+
+		enum class ESortType : uint8
+		{
+			Alpha,
+			Instances,
+			TotalMem,
+		};
+
+		EInstanceGrouping::Type Grouping = EInstanceGrouping::None;
+		ESortType SortType = ESortType::TotalMem;
+		TArray<FGroup> Groups;
+		TMap<const UObject*, int32> KeyToGroup;		// package / outer / world -> group
+		TMap<FString, int32> FolderToGroup;
+
+		void Reset(EInstanceGrouping::Type InGrouping)
+		{
+			Grouping = InGrouping;
+			Groups.Reset();
+			KeyToGroup.Reset();
+			FolderToGroup.Reset();
+		}
+
+		int32 FindOrAddGroup(const UObject* Object)
+		{
+			const UObject* KeyObject = nullptr;
+			switch (Grouping)
+			{
+				case EInstanceGrouping::OutermostPackage:
+				case EInstanceGrouping::ContentFolder:		KeyObject = Object->GetOutermost(); break;
+				case EInstanceGrouping::Outer:				KeyObject = Object->GetOuter(); break;
+				case EInstanceGrouping::World:				KeyObject = Object->IsA<UWorld>() ? Object : Object->GetTypedOuter<UWorld>(); break;
+				default:									break;
+			}
+
+			if (const int32* GroupIndex = KeyToGroup.Find(KeyObject))
+			{
+				return *GroupIndex;
+			}
+
+			// First time this key is seen: resolve its label once. Content folders need a second lookup as many packages share a folder.
+			FString Label;
+			if (KeyObject == nullptr)
+			{
+				Label = TEXT("(none)");
+			}
+			else if (Grouping == EInstanceGrouping::World)
+			{
+				Label = KeyObject->GetName();
+			}
+			else if (Grouping == EInstanceGrouping::ContentFolder)
+			{
+				Label = FPackageName::GetLongPackagePath(KeyObject->GetName());
+			}
+			else
+			{
+				Label = KeyObject->GetPathName();
+			}
+
+			int32 GroupIndex = INDEX_NONE;
+			if (const int32* FolderGroupIndex = (Grouping == EInstanceGrouping::ContentFolder) ? FolderToGroup.Find(Label) : nullptr)
+			{
+				GroupIndex = *FolderGroupIndex;
+			}
+			else
+			{
+				GroupIndex = Groups.AddDefaulted();
+				CopyUtf8(Groups[GroupIndex].Utf8Label, Label);
+				if (Grouping == EInstanceGrouping::ContentFolder)
+				{
+					FolderToGroup.Add(Label, GroupIndex);
+				}
+			}
+			KeyToGroup.Add(KeyObject, GroupIndex);
+			return GroupIndex;
+		}
+
+		void Add(const UObject* Object, float TotalMemoryMB, int32 SubKey, const ANSICHAR* SubLabel)
+		{
+			FGroup& Group = Groups[FindOrAddGroup(Object)];
+			Group.TotalMemoryMB += TotalMemoryMB;
+			++Group.Instances;
+
+			int32 SubRowIndex = INDEX_NONE;
+			if (const int32* ExistingSubRowIndex = Group.SubKeyToRow.Find(SubKey))
+			{
+				SubRowIndex = *ExistingSubRowIndex;
+			}
+			else
+			{
+				SubRowIndex = Group.SubRows.AddDefaulted();
+				Group.SubKeyToRow.Add(SubKey, SubRowIndex);
+				FRow& NewSubRow = Group.SubRows[SubRowIndex];
+				NewSubRow.SubKey = SubKey;
+				NewSubRow.Utf8Label.Append(SubLabel, FCStringAnsi::Strlen(SubLabel) + 1);
+			}
+			FRow& SubRow = Group.SubRows[SubRowIndex];
+			SubRow.TotalMemoryMB += TotalMemoryMB;
+			++SubRow.Instances;
+		}
+
+		void SortBy(ESortType InSortType)
+		{
+			SortType = InSortType;
+			const auto SortRows = [this](auto& Rows)
+			{
+				switch (SortType)
+				{
+					case ESortType::Alpha:		Rows.Sort([](const FRow& LHS, const FRow& RHS) { return FCStringAnsi::Strcmp(LHS.GetUtf8Label(), RHS.GetUtf8Label()) < 0; }); break;
+					case ESortType::Instances:	Rows.Sort([](const FRow& LHS, const FRow& RHS) { return LHS.Instances > RHS.Instances; }); break;
+					default:					Rows.Sort([](const FRow& LHS, const FRow& RHS) { return LHS.TotalMemoryMB > RHS.TotalMemoryMB; }); break;
+				}
+			};
+
+			SortRows(Groups);
+			for (FGroup& Group : Groups)
+			{
+				SortRows(Group.SubRows);
+				Group.SubKeyToRow.Reset();	// only needed while aggregating
+			}
+		}
+
+		// Draws the groups as a tree in 3 columns with sortable headers. Sub rows get a button calling OnSubRowButton with their SubKey.
+		void Draw(const char* SubRowButtonLabel, TFunctionRef<void(int32)> OnSubRowButton)
+		{
+			ImGui::Columns(3, "InstanceGroupCols");
+			ImGui::SetColumnWidth(0, FMath::Max(ImGui::GetWindowWidth() - 240.0f, 100.0f));
+			ImGui::SetColumnWidth(1, 110.0f);
+			ImGui::SetColumnWidth(2, 110.0f);
+			if (ImGui::Selectable("Group", SortType == ESortType::Alpha)) { SortBy(ESortType::Alpha); } ImGui::NextColumn();
+			if (ImGui::Selectable("Instances", SortType == ESortType::Instances)) { SortBy(ESortType::Instances); } ImGui::NextColumn();
+			if (ImGui::Selectable("Total Mem", SortType == ESortType::TotalMem)) { SortBy(ESortType::TotalMem); } ImGui::NextColumn();
+			ImGui::Separator();
+
+			for (int GroupIndex = 0; GroupIndex < Groups.Num(); ++GroupIndex)
+			{
+				const FGroup& Group = Groups[GroupIndex];
+				ImGui::PushID(GroupIndex);
+				const bool bGroupOpen = ImGui::TreeNodeEx("##Group", ImGuiTreeNodeFlags_NoTreePushOnOpen, "%s", Group.GetUtf8Label());
+				ImGui::NextColumn();
+				ImGui::Text("%d", Group.Instances); ImGui::NextColumn();
+				ImGui::Text("%.04f MB", Group.TotalMemoryMB); ImGui::NextColumn();
+
+				if (bGroupOpen)
+				{
+					ImGuiListClipper Clipper;
+					Clipper.Begin(Group.SubRows.Num());
+					while (Clipper.Step())
+					{
+						for (int SubRowIndex = Clipper.DisplayStart; SubRowIndex < Clipper.DisplayEnd; ++SubRowIndex)
+						{
+							const FRow& SubRow = Group.SubRows[SubRowIndex];
+							ImGui::Indent();
+							ImGui::PushID(SubRowIndex);
+							if (ImGui::SmallButton(SubRowButtonLabel))
+							{
+								OnSubRowButton(SubRow.SubKey);
+							}
+							ImGui::PopID();
+							ImGui::SameLine();
+							ImGui::Text("%s", SubRow.GetUtf8Label());
+							ImGui::Unindent();
+							ImGui::NextColumn();
+							ImGui::Text("%d", SubRow.Instances); ImGui::NextColumn();
+							ImGui::Text("%.04f MB", SubRow.TotalMemoryMB); ImGui::NextColumn();
+						}
+					}
+				}
+				ImGui::PopID();
+			}
+			ImGui::Columns(1);
+		}
+	};
+
+	static const char* InstanceGroupingComboItems = "None\0Outermost Package\0Outer\0World\0Content Folder\0";
+
+	// holds referencer info in a memory safe way
+	struct FReferencerInfo
+	{
+		TWeakObjectPtr<UObject> ReferencerWkPtr = nullptr;
+		TArray<FString> ReferencingProperties;
+		int TotalReferences = 0;
+	};
+
+	// One object on the shortest path from a GC root to an inspected instance, resolved from the reference graph on the game thread.
+	struct FRetentionHopInfo
+	{
+		TWeakObjectPtr<UObject> ObjectWkPtr = nullptr;
+		FString PropertyName;	// property through which this object references the next one on the path
+		bool bRoot = false;
+	};
+
+	// Reference graph shared by every instance inspector. Built on demand and reused until explicitly refreshed.
+	ImGuiTools::Utils::FObjectReferenceGraph ReferenceGraph;
+	float ReferenceGraphBudgetMs = 4.0f;
+
+	// Retained sizes: dominator tree over the reference graph, with class tree classes as groups so classes get a retained size too.
+	//	Recomputed in the background whenever the graph is rebuilt or the class indices change.
+	ImGuiTools::Utils::FObjectDominatorTree DominatorTree;
+	bool bRetainedSizeMode = false;
+	uint32 DominatorClassIndexGeneration = 0;
+
+	void UpdateRetainedSizes(const FCachedClassTree& ClassTree)
+	{
+		ReferenceGraph.bCollectNodeBytes = bRetainedSizeMode;
+		if (!bRetainedSizeMode)
+		{
+			return;
+		}
+
+		const ImGuiTools::Utils::FObjectReferenceGraph::EState GraphState = ReferenceGraph.GetState();
+		if ((GraphState == ImGuiTools::Utils::FObjectReferenceGraph::EState::Empty) || (ReferenceGraph.IsReady() && !ReferenceGraph.HasNodeBytes()))
+		{
+			ReferenceGraph.BeginRefresh();
+			return;
+		}
+
+		const bool bDominatorsStale = (DominatorTree.GetState() == ImGuiTools::Utils::FObjectDominatorTree::EState::Empty)
+			|| (DominatorTree.GetSnapshotId() != ReferenceGraph.GetSnapshotId())
+			|| (DominatorClassIndexGeneration != ClassTree.ClassIndexGeneration);
+		if (!ReferenceGraph.IsReady() || (DominatorTree.GetState() == ImGuiTools::Utils::FObjectDominatorTree::EState::Computing) || !bDominatorsStale)
+		{
+			return;
+		}
+
+		// Class tree parents always come before their children, as the dominator tree groups require.
+		TArray<int32> GroupParents;
+		GroupParents.SetNumUninitialized(ClassTree.Classes.Num());
+		for (int i = 0; i < ClassTree.Classes.Num(); ++i)
+		{
+			GroupParents[i] = ClassTree.Classes[i].ParentIndex;
+		}
+
+		TArray<int32> NodeGroups;
+		NodeGroups.Init(INDEX_NONE, ReferenceGraph.GetNumNodes());
+		const UClass* LastClass = nullptr;
+		int LastClassIndex = INDEX_NONE;
+		for (int32 NodeIndex = 0; NodeIndex < NodeGroups.Num(); ++NodeIndex)
+		{
+			if (const UObject* Object = ReferenceGraph.GetNodeObject(NodeIndex))
+			{
+				if (Object->GetClass() != LastClass)
+				{
+					LastClass = Object->GetClass();
+					LastClassIndex = ClassTree.FindClassIndex(LastClass);
+				}
+				NodeGroups[NodeIndex] = LastClassIndex;
+			}
+		}
+
+		DominatorClassIndexGeneration = ClassTree.ClassIndexGeneration;
+		DominatorTree.BeginCompute(ReferenceGraph, MoveTemp(NodeGroups), MoveTemp(GroupParents));
+	}
+
+	bool HasRetainedSizes()
+	{
+		return bRetainedSizeMode && ReferenceGraph.IsReady() && DominatorTree.IsReady() && (DominatorTree.GetSnapshotId() == ReferenceGraph.GetSnapshotId());
+	}
+
+	void DrawRetainedSizeProgress()
+	{
+		if (!bRetainedSizeMode || HasRetainedSizes())
+		{
+			return;
+		}
+
+		const bool bBuildingGraph = !ReferenceGraph.IsReady();
+		ImGui::ProgressBar(bBuildingGraph ? ReferenceGraph.GetProgress() : DominatorTree.GetProgress(), ImVec2(200.0f, 0.0f), bBuildingGraph ? "Collecting references..." : "Computing dominators...");
+	}
+
+	// Draws one Retained Mem cell, "..." while the dominator tree is being computed.
+	void DrawRetainedBytesCell(uint64 Bytes)
+	{
+		if (HasRetainedSizes())
+		{
+			ImGui::Text("%.04f MB", BytesToMB(Bytes));
+		}
+		else
+		{
+			ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "...");
+		}
+	}
+
+	// Struct for a single inspected instance
+	struct FInspectedInstanceInfo
+	{
+		TWeakObjectPtr<UObject> InspectedWkPtr = nullptr;
+		TArray<FReferencerInfo> CachedInternalReferencers;
+		TArray<FReferencerInfo> CachedExternalReferencers;
+
+		int32 InspectedNodeIndex = INDEX_NONE;
+		uint32 CachedGraphSnapshotId = 0;	// snapshot the cached referencers were taken from, 0 while streaming from a graph still being built
+		int32 NumStreamedReferencers = 0;
+		TMap<int32, TPair<bool, int32>> ReferencerNodeToEntry;	// referencer node -> (internal, index into the cached list)
+
+		// "Explain retention": shortest path from a GC root, searched on a worker thread once the reference graph is ready.
+		bool bRetentionRequested = false;
+		bool bRetentionSearched = false;
+		bool bRetentionNotInGraph = false;	// the instance was created after the graph snapshot, so there is nothing to search
+		uint32 RetentionSnapshotId = 0;
+		TFuture<TArray<ImGuiTools::Utils::FObjectReferenceGraph::FPathHop>> RetentionSearch;
+		TArray<FRetentionHopInfo> RetentionPath;
+
+		void UpdateInspectedInstanceReferencers()
+		{
+			// Referencers come from the shared reference graph. The first inspection starts building it, results stream in while it
+			//	builds, and every later inspection is a lookup until the graph is refreshed.
+			ResetCachedReferencers();
+			InspectedNodeIndex = INDEX_NONE;
+
+			UObject* InspectedInstanceRawPtr = InspectedWkPtr.Get();
+			if (IsValid(InspectedInstanceRawPtr))
+			{
+				if (ReferenceGraph.GetState() == ImGuiTools::Utils::FObjectReferenceGraph::EState::Empty)
+				{
+					ReferenceGraph.BeginRefresh();
+				}
+
+				InspectedNodeIndex = ReferenceGraph.FindNode(InspectedInstanceRawPtr);
+				if (InspectedNodeIndex == INDEX_NONE)
+				{
+					InspectedNodeIndex = GUObjectArray.ObjectToIndex(InspectedInstanceRawPtr);	// not collected yet
+				}
+				ReferenceGraph.WatchReferencers(InspectedNodeIndex);
+				PullReferencersFromGraph();
+			}
+		}
+
+		// Called every frame the instance is shown. Picks up referencers streamed in since the last call, or the full results once the graph is ready.
+		void PullReferencersFromGraph()
+		{
+			UObject* InspectedInstanceRawPtr = InspectedWkPtr.Get();
+			if ((InspectedNodeIndex == INDEX_NONE) || !IsValid(InspectedInstanceRawPtr))
+			{
+				return;
+			}
+
+			if (ReferenceGraph.IsReady())
+			{
+				if (CachedGraphSnapshotId != ReferenceGraph.GetSnapshotId())
+				{
+					ResetCachedReferencers();
+					CachedGraphSnapshotId = ReferenceGraph.GetSnapshotId();
+
+					TArray<ImGuiTools::Utils::FObjectReferenceGraph::FReference> Referencers;
+					ReferenceGraph.GetReferencers(ReferenceGraph.FindNode(InspectedInstanceRawPtr), Referencers);
+					for (const ImGuiTools::Utils::FObjectReferenceGraph::FReference& Referencer : Referencers)
+					{
+						AddReferencer(InspectedInstanceRawPtr, Referencer);
+					}
+				}
+			}
+			else if (const TArray<ImGuiTools::Utils::FObjectReferenceGraph::FReference>* Streamed = ReferenceGraph.GetStreamedReferencers(InspectedNodeIndex))
+			{
+				for (; NumStreamedReferencers < Streamed->Num(); ++NumStreamedReferencers)
+				{
+					AddReferencer(InspectedInstanceRawPtr, (*Streamed)[NumStreamedReferencers]);
+				}
+			}
+		}
+
+		void AddReferencer(UObject* InspectedInstanceRawPtr, const ImGuiTools::Utils::FObjectReferenceGraph::FReference& Referencer)
+		{
+			TPair<bool, int32>* Entry = ReferencerNodeToEntry.Find(Referencer.NodeIndex);
+			if (Entry == nullptr)
+			{
+				UObject* ReferencerObject = ReferenceGraph.GetNodeObject(Referencer.NodeIndex);
+				const bool bInternal = (ReferencerObject != nullptr) && ReferencerObject->IsIn(InspectedInstanceRawPtr);
+				TArray<FReferencerInfo>& ReferencerList = bInternal ? CachedInternalReferencers : CachedExternalReferencers;
+
+				FReferencerInfo& NewReferencerInfo = ReferencerList.AddDefaulted_GetRef();
+				NewReferencerInfo.ReferencerWkPtr = ReferencerObject;
+				Entry = &ReferencerNodeToEntry.Add(Referencer.NodeIndex, TPair<bool, int32>(bInternal, ReferencerList.Num() - 1));
+			}
+
+			FReferencerInfo& ReferencerInfo = (Entry->Key ? CachedInternalReferencers : CachedExternalReferencers)[Entry->Value];
+			++ReferencerInfo.TotalReferences;
+			const FName PropertyName = ReferenceGraph.GetPropertyName(Referencer.PropertyIndex);
+			if (!PropertyName.IsNone())
+			{
+				ReferencerInfo.ReferencingProperties.AddUnique(PropertyName.ToString());
+			}
+		}
+
+		void ResetCachedReferencers()
+		{
+			CachedInternalReferencers.Empty();
+			CachedExternalReferencers.Empty();
+			ReferencerNodeToEntry.Empty();
+			CachedGraphSnapshotId = 0;
+			NumStreamedReferencers = 0;
+		}
+
+		void RequestRetentionPath()
+		{
+			bRetentionRequested = true;
+			bRetentionSearched = false;
+			bRetentionNotInGraph = false;
+			RetentionSearch = {};
+			RetentionPath.Empty();
+			if (ReferenceGraph.GetState() == ImGuiTools::Utils::FObjectReferenceGraph::EState::Empty)
+			{
+				ReferenceGraph.BeginRefresh();
+			}
+		}
+
+		// Called every frame the instance is shown. Starts the search once the graph is ready and resolves the result when it lands.
+		void UpdateRetentionPath()
+		{
+			if (!bRetentionRequested)
+			{
+				return;
+			}
+
+			UObject* InspectedInstanceRawPtr = InspectedWkPtr.Get();
+			if (!IsValid(InspectedInstanceRawPtr) || !ReferenceGraph.IsReady())
+			{
+				return;
+			}
+
+			if (!RetentionSearch.IsValid())
+			{
+				const int32 NodeIndex = ReferenceGraph.FindNode(InspectedInstanceRawPtr);
+				if (NodeIndex == INDEX_NONE)
+				{
+					bRetentionRequested = false;
+					bRetentionSearched = true;
+					bRetentionNotInGraph = true;
+					return;
+				}
+
+				RetentionSnapshotId = ReferenceGraph.GetSnapshotId();
+				RetentionSearch = ReferenceGraph.FindRootPathAsync(NodeIndex);
+				return;
+			}
+
+			if (!RetentionSearch.IsReady())
+			{
+				return;
+			}
+
+			const TArray<ImGuiTools::Utils::FObjectReferenceGraph::FPathHop> Hops = RetentionSearch.Get();
+			RetentionSearch = {};
+			if (RetentionSnapshotId != ReferenceGraph.GetSnapshotId())
+			{
+				return;	// graph was rebuilt while searching, node indices are stale so search again
+			}
+
+			for (const ImGuiTools::Utils::FObjectReferenceGraph::FPathHop& Hop : Hops)
+			{
+				FRetentionHopInfo& HopInfo = RetentionPath.AddDefaulted_GetRef();
+				HopInfo.ObjectWkPtr = ReferenceGraph.GetNodeObject(Hop.NodeIndex);
+				HopInfo.bRoot = ReferenceGraph.IsRootNode(Hop.NodeIndex);
+				const FName PropertyName = ReferenceGraph.GetPropertyName(Hop.PropertyIndex);
+				if (!PropertyName.IsNone())
+				{
+					HopInfo.PropertyName = PropertyName.ToString();
+				}
+			}
+			bRetentionRequested = false;
+			bRetentionSearched = true;
+		}
+
+		void ResetRetentionPath()
+		{
+			bRetentionRequested = false;
+			bRetentionSearched = false;
+			bRetentionNotInGraph = false;
+			RetentionSearch = {};
+			RetentionPath.Empty();
+		}
+
+		void SetInpectedInstance(const TWeakObjectPtr<UObject>& NewInpectedInstance)
+		{
+			if (NewInpectedInstance.IsValid())
+			{
+				InspectedWkPtr = NewInpectedInstance;
+				ResetRetentionPath();
+				UpdateInspectedInstanceReferencers();
+			}
+		}
+	};
+
+	struct FInstanceInspectorInfo
+	{
+		TWeakObjectPtr<UClass> Class = nullptr;
+		FMemInfo MemInfo;
+		int Instances = 0;
+		EMemSortType::Type SortType = EMemSortType::TotalMem;
+		ImGuiTools::Utils::FShowCols ShowCols = ImGuiTools::Utils::FShowCols(EColumnTypes::COUNT, &EColumnTypes::DefaultVisibility[0]);
+		FInspectedInstanceInfo InspectedInstance;
+		TArray<FInstanceInspectorInstanceInfo> InstanceInfos;
+		ImGuiTextFilter NameFilter;
+		TArray<int32> VisibleIndices;	// InstanceInfos passing NameFilter, in sort order. Rebuilt only when the list, sort or filter change.
+		bool bVisibleIndicesDirty = true;
+		bool bAutoRefresh = false;	// option to auto refresh the instance view
+		float AutoRefreshTime = 4.0f; // interval to auto refresh the instance view
+		float AutoRefreshTimer = 0.0f;	// current timer from last time auto refresh occurred.
+		bool bTopNMode = false;	// only keep the TopN largest instances by the sort column, for cheap refreshes of huge classes
+		int32 TopN = 100;
+		EMemSortType::Type TopNSortType = EMemSortType::None;	// column the kept instances were selected by
+		EInstanceGrouping::Type Grouping = EInstanceGrouping::None;
+		FInstanceGroupTree GroupTree;
+		uint32 ListVersion = 0;	// bumped whenever InstanceInfos is rebuilt, so the group tree knows to rebuild
+		uint32 GroupTreeListVersion = 0;
+
+		// Fill the instance list from the instance records kept by the last class tree gather, without touching the object array.
+		void LoadFromClassTreeRecords(const FCachedClassTree& ClassTree, int RootClassIndex)
+		{
+			MemInfo = {};
+			Instances = 0;
+			InstanceInfos.Empty();
+
+			TArray<int, TInlineAllocator<64>> ClassStack;
+			ClassStack.Add(RootClassIndex);
+			while (ClassStack.Num() > 0)
+			{
+				const int ClassIndex = ClassStack.Pop(/*bAllowShrinking*/ false);
+				ClassStack.Append(ClassTree.Classes[ClassIndex].ChildIndicies);
+
+				for (const FInstanceRecord& Record : ClassTree.GetInstanceRecords(ClassIndex))
+				{
+					FMemInfo InstMemInfo;
+					InstMemInfo.TotalMemoryMB = BytesToMB(Record.Bytes[EMemColumn::TotalMem]);
+					InstMemInfo.UnknownMemoryMB = BytesToMB(Record.Bytes[EMemColumn::UnknownMem]);
+					InstMemInfo.DedSysMemoryMB = BytesToMB(Record.Bytes[EMemColumn::DedSysMem]);
+					InstMemInfo.DedVidMemoryMB = BytesToMB(Record.Bytes[EMemColumn::DedVidMem]);
+					InstMemInfo.SharedSysMemoryMB = BytesToMB(Record.Bytes[EMemColumn::SharedSysMem]);
+					InstMemInfo.SharedVidMemoryMB = BytesToMB(Record.Bytes[EMemColumn::SharedVidMem]);
+					AddGatheredInstance(Record.Object, InstMemInfo);
+				}
+			}
+
+			FinishGather();
+		}
+
+		void UpdateObjectMemoryInfo(bool IncludeCDO, EResourceSizeMode::Type ResourceSizeMode = EResourceSizeMode::Exclusive)
+		{
+			MemInfo = {};
+			Instances = 0;
+			InstanceInfos.Reset();
+
+			ObjectClassBuckets.RefreshForFrame();
+			ObjectClassBuckets.ForEachObjectOfClass(Class.Get(), [&](UObject* Object)
+			{
+				if (!IncludeCDO && Object->IsTemplate(RF_ClassDefaultObject))
+				{
+					return;
+				}
+
+				FResourceSizeEx TrueResourceSize = FResourceSizeEx(ResourceSizeMode);
+				Object->GetResourceSizeEx(TrueResourceSize);
+
+				FMemInfo InstMemInfo;
+				InstMemInfo.TotalMemoryMB = (float)TrueResourceSize.GetTotalMemoryBytes()/1024.0f/1024.0f;
+				InstMemInfo.UnknownMemoryMB = (float)TrueResourceSize.GetUnknownMemoryBytes() / 1024.0f / 1024.0f;
+				InstMemInfo.DedSysMemoryMB = (float)TrueResourceSize.GetDedicatedSystemMemoryBytes() / 1024.0f / 1024.0f;
+				InstMemInfo.DedVidMemoryMB = (float)TrueResourceSize.GetDedicatedVideoMemoryBytes() / 1024.0f / 1024.0f;
+#if ENGINE_MAJOR_VERSION == 4
+				InstMemInfo.SharedSysMemoryMB = (float)TrueResourceSize.GetSharedSystemMemoryBytes() / 1024.0f / 1024.0f;
+				InstMemInfo.SharedVidMemoryMB = (float)TrueResourceSize.GetSharedVideoMemoryBytes() / 1024.0f / 1024.0f;
+#endif // #if ENGINE_MAJOR_VERSION == 4
+				AddGatheredInstance(Object, InstMemInfo);
+			});
+
+			FinishGather();
+		}
+
+		// Column Top N keeps the largest instances of. Alpha has no notion of largest, so it keeps the largest by total memory.
+		EMemSortType::Type GetTopNSortType() const
+		{
+			return (SortType == EMemSortType::Alpha) ? EMemSortType::TotalMem : SortType;
+		}
+
+		static float GetSortKey(const FMemInfo& InstMemInfo, EMemSortType::Type InSortType)
+		{
+			switch (InSortType)
+			{
+				case EMemSortType::UnknownMem:		return InstMemInfo.UnknownMemoryMB;
+				case EMemSortType::DedSysMem:		return InstMemInfo.DedSysMemoryMB;
+				case EMemSortType::DedVidMem:		return InstMemInfo.DedVidMemoryMB;
+				case EMemSortType::SharedSysMem:	return InstMemInfo.SharedSysMemoryMB;
+				case EMemSortType::SharedVidMem:	return InstMemInfo.SharedVidMemoryMB;
+				default:							return InstMemInfo.TotalMemoryMB;
+			}
+		}
+
+		// Totals always cover every instance. In Top N mode only the N largest are kept, in a min-heap so each instance costs one
+		//	compare against the smallest kept one, and names are only cached for the survivors in FinishGather().
+		void AddGatheredInstance(const FWeakObjectPtr& Object, const FMemInfo& InstMemInfo)
+		{
+			MemInfo.TotalMemoryMB += InstMemInfo.TotalMemoryMB;
+			MemInfo.UnknownMemoryMB += InstMemInfo.UnknownMemoryMB;
+			MemInfo.DedSysMemoryMB += InstMemInfo.DedSysMemoryMB;
+			MemInfo.DedVidMemoryMB += InstMemInfo.DedVidMemoryMB;
+			MemInfo.SharedSysMemoryMB += InstMemInfo.SharedSysMemoryMB;
+			MemInfo.SharedVidMemoryMB += InstMemInfo.SharedVidMemoryMB;
+			++Instances;
+
+			if (bTopNMode)
+			{
+				const EMemSortType::Type KeyType = GetTopNSortType();
+				const auto SmallestFirst = [KeyType](const FInstanceInspectorInstanceInfo& LHS, const FInstanceInspectorInstanceInfo& RHS) { return GetSortKey(LHS.MemInfo, KeyType) < GetSortKey(RHS.MemInfo, KeyType); };
+				if (InstanceInfos.Num() >= TopN)
+				{
+					if ((TopN <= 0) || (GetSortKey(InstMemInfo, KeyType) <= GetSortKey(InstanceInfos.HeapTop().MemInfo, KeyType)))
+					{
+						return;
+					}
+					InstanceInfos.HeapPopDiscard(SmallestFirst);
+				}
+
+				FInstanceInspectorInstanceInfo InstInfo;
+				InstInfo.InstanceWkPtr = Object.Get();
+				InstInfo.MemInfo = InstMemInfo;
+				InstanceInfos.HeapPush(MoveTemp(InstInfo), SmallestFirst);
+				return;
+			}
+
+			FInstanceInspectorInstanceInfo& InstInfo = InstanceInfos.AddDefaulted_GetRef();
+			InstInfo.InstanceWkPtr = Object.Get();
+			InstInfo.MemInfo = InstMemInfo;
+		}
+
+		void FinishGather()
+		{
+			for (FInstanceInspectorInstanceInfo& InstInfo : InstanceInfos)
+			{
+				InstInfo.CacheNames(InstInfo.InstanceWkPtr.Get());
+			}
+			TopNSortType = GetTopNSortType();
+			++ListVersion;
+			SortBy(SortType);
+		}
+
+		void UpdateGroupTree()
+		{
+			if ((GroupTree.Grouping == Grouping) && (GroupTreeListVersion == ListVersion))
+			{
+				return;
+			}
+
+			GroupTreeListVersion = ListVersion;
+			GroupTree.Reset(Grouping);
+			for (int32 i = 0; i < InstanceInfos.Num(); ++i)
+			{
+				if (const UObject* Object = InstanceInfos[i].InstanceWkPtr.Get())
+				{
+					GroupTree.Add(Object, InstanceInfos[i].MemInfo.TotalMemoryMB, i, InstanceInfos[i].GetUtf8Name());
+				}
+			}
+			GroupTree.SortBy(GroupTree.SortType);
+		}
+
+		// True when Top N kept the largest instances by another column than the current sort, so it needs a new gather.
+		bool NeedsTopNRegather() const
+		{
+			return bTopNMode && (TopNSortType != GetTopNSortType());
+		}
+
+		void UpdateVisibleIndices()
+		{
+			if (!bVisibleIndicesDirty)
+			{
+				return;
+			}
+
+			bVisibleIndicesDirty = false;
+			VisibleIndices.Reset(InstanceInfos.Num());
+			for (int32 i = 0; i < InstanceInfos.Num(); ++i)
+			{
+				if (!NameFilter.IsActive() || NameFilter.PassFilter(InstanceInfos[i].GetUtf8Name()))
+				{
+					VisibleIndices.Add(i);
+				}
+			}
+		}
+
+		void SortBy(EMemSortType::Type InSortType)
+		{
+			SortType = InSortType;
+			bVisibleIndicesDirty = true;
+			switch (SortType)
+			{
+				case EMemSortType::Alpha:
+					InstanceInfos.Sort([](const FInstanceInspectorInstanceInfo& LHS, const FInstanceInspectorInstanceInfo& RHS) { return FCStringAnsi::Strcmp(LHS.GetUtf8Name(), RHS.GetUtf8Name()) < 0; });
+					break;
+
+				case EMemSortType::TotalMem:
+				case EMemSortType::UnknownMem:
+				case EMemSortType::DedSysMem:
+				case EMemSortType::DedVidMem:
+				case EMemSortType::SharedSysMem:
+				case EMemSortType::SharedVidMem:
+					InstanceInfos.Sort([this](const FInstanceInspectorInstanceInfo& LHS, const FInstanceInspectorInstanceInfo& RHS) { return GetSortKey(LHS.MemInfo, SortType) > GetSortKey(RHS.MemInfo, SortType); });
+					break;
+
+				default:
+				case EMemSortType::Instances:
+					UE_LOG(LogImGuiDebugMem, Error, TEXT("FInstanceInspectorInfo::SortBy() - sorting with unimplemented type. not doing anything!"));
+					break;
+			}
+		}
+	};
+
+	FCachedClassTree CachedClassTree;
+	TArray<FInstanceInspectorInfo> InstanceInspectors;
+	TWeakObjectPtr<UClass> PopupClass;
+	// Flattened list of the class tree rows currently visible. Rebuilt only when expansion state, filters or the class tree change,
+	//	so drawing only touches the rows on screen.
+	struct FClassTreeView
+	{
+		struct FRow
+		{
+			int ClassIndex = INDEX_NONE;
+			int Depth = 0;
+		};
+
+		TArray<FRow> Rows;
+		TBitArray<> ExpandedClasses;		// expansion state while no name filter is active
+		TBitArray<> FilterCollapsedClasses;	// classes collapsed while a name filter is active, everything starts expanded when the filter changes
+		uint32 CachedTreeVersion = 0;
+		uint32 CachedClassIndexGeneration = 0;
+		bool bDirty = true;
+
+		// Name filter results per class, only re-evaluated when the filter text or the set of classes changes.
+		TBitArray<> FilterSelfPasses;
+		TBitArray<> FilterSelfOrDescendantPasses;
+		bool bFilterResultsDirty = true;
+
+		void MarkDirty()
+		{
+			bDirty = true;
+		}
+
+		void OnFilterChanged()
+		{
+			FilterCollapsedClasses.Init(false, FilterCollapsedClasses.Num());
+			bFilterResultsDirty = true;
+			bDirty = true;
+		}
+
+		// Test every class name against the filter once, then flag each class that passes or has a passing descendant. Parents are
+		//	always cached before their children, so a single reverse pass propagates results up the tree.
+		void UpdateFilterResults(const FCachedClassTree& ClassTree, const ImGuiTextFilter& ClassNameFilter)
+		{
+			const int NumClasses = ClassTree.Classes.Num();
+			FilterSelfPasses.Init(false, NumClasses);
+			FilterSelfOrDescendantPasses.Init(false, NumClasses);
+			for (int i = 0; i < NumClasses; ++i)
+			{
+				const FCachedClassInfo& ClassInfo = ClassTree.Classes[i];
+				FilterSelfPasses[i] = (ClassInfo.Utf8Name.Num() > 0) && ClassNameFilter.PassFilter(ClassInfo.GetUtf8Name());
+			}
+
+			for (int i = NumClasses - 1; i >= 0; --i)
+			{
+				if (FilterSelfPasses[i] || FilterSelfOrDescendantPasses[i])
+				{
+					FilterSelfOrDescendantPasses[i] = true;
+					const int ParentIndex = ClassTree.Classes[i].ParentIndex;
+					if (ParentIndex != INDEX_NONE)
+					{
+						FilterSelfOrDescendantPasses[ParentIndex] = true;
+					}
+				}
+			}
+			bFilterResultsDirty = false;
+		}
+
+		bool NeedsRebuild(const FCachedClassTree& ClassTree) const
+		{
+			return bDirty || (CachedTreeVersion != ClassTree.TreeVersion) || (CachedClassIndexGeneration != ClassTree.ClassIndexGeneration);
+		}
+
+		bool IsExpanded(int ClassIndex, bool bFilterActive) const
+		{
+			return bFilterActive ? !FilterCollapsedClasses[ClassIndex] : ExpandedClasses[ClassIndex];
+		}
+
+		void SetExpanded(int ClassIndex, bool bFilterActive, bool bExpanded)
+		{
+			if (bFilterActive)
+			{
+				FilterCollapsedClasses[ClassIndex] = !bExpanded;
+			}
+			else
+			{
+				ExpandedClasses[ClassIndex] = bExpanded;
+			}
+			bDirty = true;
+		}
+
+		void RebuildRows(const FCachedClassTree& ClassTree, bool FilterZeroInstances, const ImGuiTextFilter& ClassNameFilter)
+		{
+			if (CachedClassIndexGeneration != ClassTree.ClassIndexGeneration)
+			{
+				ExpandedClasses.Empty();
+				FilterCollapsedClasses.Empty();
+				bFilterResultsDirty = true;
+				CachedClassIndexGeneration = ClassTree.ClassIndexGeneration;
+			}
+
+			// Classes cached since the last rebuild start collapsed, except for the root.
+			for (int i = ExpandedClasses.Num(); i < ClassTree.Classes.Num(); ++i)
+			{
+				ExpandedClasses.Add(i == ClassTree.RootIndex);
+				FilterCollapsedClasses.Add(false);
+			}
+
+			if (ClassNameFilter.IsActive() && (bFilterResultsDirty || (FilterSelfPasses.Num() != ClassTree.Classes.Num())))
+			{
+				UpdateFilterResults(ClassTree, ClassNameFilter);
+			}
+
+			Rows.Reset();
+			if (ClassTree.Classes.IsValidIndex(ClassTree.RootIndex))
+			{
+				AddRows(ClassTree, ClassTree.RootIndex, 0, FilterZeroInstances, ClassNameFilter);
+			}
+
+			CachedTreeVersion = ClassTree.TreeVersion;
+			bDirty = false;
+		}
+
+		void AddRows(const FCachedClassTree& ClassTree, int Index, int Depth, bool FilterZeroInstances, const ImGuiTextFilter& ClassNameFilter)
+		{
+			const FCachedClassInfo& CachedClassInfo = ClassTree.Classes[Index];
+			if (FilterZeroInstances && (ClassTree.GetTotalInstances(Index) == 0))
+			{
+				return;
+			}
+
+			// Classes failing the name filter are skipped, but their passing descendants are still listed in their place.
+			const bool bFilterActive = ClassNameFilter.IsActive();
+			if (bFilterActive && !FilterSelfOrDescendantPasses[Index])
+			{
+				return;
+			}
+			if (bFilterActive && !FilterSelfPasses[Index])
+			{
+				for (int ChildIndex : CachedClassInfo.ChildIndicies)
+				{
+					AddRows(ClassTree, ChildIndex, Depth, FilterZeroInstances, ClassNameFilter);
+				}
+				return;
+			}
+
+			Rows.Add({ Index, Depth });
+			if (IsExpanded(Index, bFilterActive))
+			{
+				for (int ChildIndex : CachedClassInfo.ChildIndicies)
+				{
+					AddRows(ClassTree, ChildIndex, Depth + 1, FilterZeroInstances, ClassNameFilter);
+				}
+			}
+		}
+	};
+
+	FClassTreeView ClassTreeView;
+
+	void DrawGrowthTrackingControls(const FCachedClassTree& ClassTree)
+	{
+		bool bTracking = ClassGrowthTracker.IsEnabled();
+		if (ImGui::Checkbox("Track Growth", &bTracking))
+		{
+			ClassGrowthTracker.SetEnabled(bTracking);
+		}
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::SetTooltip("Sample per-class instance counts from the live counters (enables Live Counts). Right click a class to also track its total bytes.");
+		}
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(80.0f);
+		ImGui::DragFloat("Interval (s)", &ClassGrowthTracker.SampleInterval, 0.1f, 0.5f, 600.0f, "%.01f");
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(80.0f);
+		ImGui::DragInt("Leak Window (samples)", &ClassGrowthTracker.LeakWindow, 0.1f, 3, FClassGrowthTracker::NumSamples);
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(80.0f);
+		ImGui::DragInt("Min Growth Steps", &ClassGrowthTracker.MinGrowthSteps, 0.1f, 1, FClassGrowthTracker::NumSamples - 1);
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::SetTooltip("Steps within the leak window where the count must strictly increase for a class to be flagged.");
+		}
+		ImGui::SameLine();
+		if (ImGui::SmallButton("Reset History"))
+		{
+			ClassGrowthTracker.Reset();
+		}
+
+		if (!ClassGrowthTracker.IsEnabled())
+		{
+			return;
+		}
+
+		ImGui::Text("%d / %d samples", ClassGrowthTracker.NumValidSamples, FClassGrowthTracker::NumSamples);
+
+		TArray<int> Suspects;
+		for (int i = 0; i < ClassTree.Classes.Num(); ++i)
+		{
+			if (ClassGrowthTracker.IsLeakSuspect(i))
+			{
+				Suspects.Add(i);
+			}
+		}
+		Suspects.Sort([](int LHS, int RHS) { return ClassGrowthTracker.GetSlope(LHS) > ClassGrowthTracker.GetSlope(RHS); });
+
+		ImGui::TextColored(Suspects.Num() > 0 ? ImVec4(1.0f, 0.3f, 0.3f, 1.0f) : ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "Leak suspects: %d", Suspects.Num());
+		for (int i = 0; i < FMath::Min(Suspects.Num(), 20); ++i)
+		{
+			const int ClassIndex = Suspects[i];
+			ClassGrowthTracker.DrawCountSparkline(ClassIndex, 80.0f);
+			ImGui::SameLine();
+			ImGui::Text("%+.01f/m  %d  %s", ClassGrowthTracker.GetSlope(ClassIndex), ClassGrowthTracker.GetCountSample(ClassIndex, 0), ClassTree.Classes[ClassIndex].GetUtf8Name());
+		}
+
+		int UnwatchIndex = INDEX_NONE;
+		for (const TPair<int, FClassGrowthTracker::FBytesHistory>& Watched : ClassGrowthTracker.WatchedBytes)
+		{
+			if (!ClassTree.Classes.IsValidIndex(Watched.Key))
+			{
+				continue;
+			}
+
+			ClassGrowthTracker.DrawBytesSparkline(Watched.Key, 120.0f);
+			ImGui::SameLine();
+			ImGui::Text("%.02f MB  %s", (Watched.Value.Num() > 0) ? Watched.Value.Get(0) : 0.0f, ClassTree.Classes[Watched.Key].GetUtf8Name());
+			ImGui::SameLine();
+			ImGui::PushID(Watched.Key);
+			if (ImGui::SmallButton("Untrack"))
+			{
+				UnwatchIndex = Watched.Key;
+			}
+			ImGui::PopID();
+		}
+		if (UnwatchIndex != INDEX_NONE)
+		{
+			ClassGrowthTracker.ToggleWatched(UnwatchIndex);
+		}
+	}
+
+	void OpenInstanceInspector(const FCachedClassTree& ClassTree, int ClassIndex)
+	{
+		FInstanceInspectorInfo& InstInfo = InstanceInspectors.AddDefaulted_GetRef();
+		InstInfo.Class = ClassTree.Classes[ClassIndex].Class;
+		if (ClassTree.HasInstanceRecords())
+		{
+			InstInfo.LoadFromClassTreeRecords(ClassTree, ClassIndex);
+		}
+	}
+
+	// Object Memory grouping, aggregated from the instance records of the last class tree gather with classes as sub rows.
+	EInstanceGrouping::Type ClassTreeGrouping = EInstanceGrouping::None;
+	FInstanceGroupTree ClassTreeGroupTree;
+	uint32 ClassTreeGroupTreeVersion = 0;
+
+	void DrawClassTreeGroups(FCachedClassTree& ClassTree)
+	{
+		if (!ClassTree.HasInstanceRecords())
+		{
+			ImGui::Text("Grouping needs per-instance data: enable 'Keep Instance Data' and update.");
+			return;
+		}
+
+		if ((ClassTreeGroupTree.Grouping != ClassTreeGrouping) || (ClassTreeGroupTreeVersion != ClassTree.TreeVersion))
+		{
+			ClassTreeGroupTreeVersion = ClassTree.TreeVersion;
+			ClassTreeGroupTree.Reset(ClassTreeGrouping);
+			for (int ClassIndex = 0; ClassIndex < ClassTree.Classes.Num(); ++ClassIndex)
+			{
+				for (const FInstanceRecord& Record : ClassTree.GetInstanceRecords(ClassIndex))
+				{
+					if (const UObject* Object = Record.Object.Get())
+					{
+						ClassTreeGroupTree.Add(Object, BytesToMB(Record.Bytes[EMemColumn::TotalMem]), ClassIndex, ClassTree.Classes[ClassIndex].GetUtf8Name());
+					}
+				}
+			}
+			ClassTreeGroupTree.SortBy(ClassTreeGroupTree.SortType);
+		}
+
+		ClassTreeGroupTree.Draw("Inspect", [&ClassTree](int32 ClassIndex) { OpenInstanceInspector(ClassTree, ClassIndex); });
+	}
+
+	// Draw the visible class tree rows, clipped to the rows on screen. Returns false if a drawn class has gone stale.
+	bool DrawClassTreeRows(FCachedClassTree& ClassTree, FClassTreeView& TreeView, bool FilterZeroInstances, ImGuiTextFilter& ClassNameFilter, ImGuiTools::Utils::FShowCols& ShowCols)
+	{
+		if (TreeView.NeedsRebuild(ClassTree))
+		{
+			TreeView.RebuildRows(ClassTree, FilterZeroInstances, ClassNameFilter);
+		}
+
+		static ImGuiTreeNodeFlags base_flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_AllowOverlap | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+		const bool bFilterActive = ClassNameFilter.IsActive();
+		const float IndentSpacing = ImGui::GetStyle().IndentSpacing;
+		const float InspectButtonPos = ImGui::GetWindowWidth() - ((ShowCols.GetCachedShowColCount() + 1) * 110.0f) + 44.0f;
+
+		ImGuiListClipper Clipper;
+		Clipper.Begin(TreeView.Rows.Num());
+		while (Clipper.Step())
+		{
+			for (int RowIndex = Clipper.DisplayStart; RowIndex < Clipper.DisplayEnd; ++RowIndex)
+			{
+				const FClassTreeView::FRow& Row = TreeView.Rows[RowIndex];
+				const int Index = Row.ClassIndex;
+				FCachedClassInfo& CachedClassInfo = ClassTree.Classes[Index];
+				if (CachedClassInfo.Class.IsStale() || !CachedClassInfo.Class.IsValid())
+				{
+					return false; // return false when data is bad
+				}
+
+				ImGuiTreeNodeFlags node_flags = base_flags;
+				if (CachedClassInfo.ChildIndicies.Num() == 0)
+				{
+					node_flags |= ImGuiTreeNodeFlags_Leaf;
+				}
+
+				const bool bWasExpanded = TreeView.IsExpanded(Index, bFilterActive);
+				ImGui::SetCursorPosX(ImGui::GetCursorPosX() + (Row.Depth * IndentSpacing));
+				ImGui::SetNextItemOpen(bWasExpanded, ImGuiCond_Always);
+				const bool TreeOpen = ImGui::TreeNodeEx((void*)CachedClassInfo.Class.Get(), node_flags, "%s%s", CachedClassInfo.GetUtf8Name(), CachedClassInfo.bAbstract ? "(abstract)" : "");
+				if (TreeOpen != bWasExpanded)
+				{
+					TreeView.SetExpanded(Index, bFilterActive, TreeOpen);
+				}
+				if (ImGui::BeginPopupContextItem())
+				{
+					if (ImGui::MenuItem("Track Total Bytes", nullptr, ClassGrowthTracker.IsWatched(Index)))
+					{
+						ClassGrowthTracker.ToggleWatched(Index);
+					}
+					ImGui::EndPopup();
+				}
+				ImGui::SameLine(InspectButtonPos);
+
+				ImGui::PushID(Index);
+				if (ImGui::SmallButton("Inspect"))
+				{
+					OpenInstanceInspector(ClassTree, Index);
+				}
+				ImGui::PopID();
+
+				ImGui::NextColumn();
+				if (ShowCols.GetShowCol(EColumnTypes::Instances))
+				{
+					if (LiveObjectCounter.HasClassTotals(Index))
+					{
+						const float NetRate = LiveObjectCounter.ClassSpawnRates[Index] - LiveObjectCounter.ClassDestroyRates[Index];
+						ImGui::Text("%d (%+.01f/s)", LiveObjectCounter.ClassInstances[Index], NetRate);
+						if (ImGui::IsItemHovered())
+						{
+							ImGui::SetTooltip("Live: %d\nSpawned: %.01f/s\nDestroyed: %.01f/s\nLast scan: %d", LiveObjectCounter.ClassInstances[Index], LiveObjectCounter.ClassSpawnRates[Index], LiveObjectCounter.ClassDestroyRates[Index], ClassTree.GetTotalInstances(Index));
+						}
+					}
+					else
+					{
+						ImGui::Text("%d", ClassTree.GetTotalInstances(Index));
+					}
+					ImGui::NextColumn();
+				}
+				if (ShowCols.GetShowCol(EColumnTypes::TotalMem)) { ImGui::Text("%.04f MB", BytesToMB(ClassTree.GetTotalBytes(Index, EMemColumn::TotalMem))); ImGui::NextColumn(); }
+				if (ShowCols.GetShowCol(EColumnTypes::UnknownMem)) { ImGui::Text("%.04f MB", BytesToMB(ClassTree.GetTotalBytes(Index, EMemColumn::UnknownMem))); ImGui::NextColumn(); }
+				if (ShowCols.GetShowCol(EColumnTypes::DedSysMem)) { ImGui::Text("%.04f MB", BytesToMB(ClassTree.GetTotalBytes(Index, EMemColumn::DedSysMem))); ImGui::NextColumn(); }
+				if (ShowCols.GetShowCol(EColumnTypes::DedVidMem)) { ImGui::Text("%.04f MB", BytesToMB(ClassTree.GetTotalBytes(Index, EMemColumn::DedVidMem))); ImGui::NextColumn(); }
+				if (ShowCols.GetShowCol(EColumnTypes::SharedSysMem)) { ImGui::Text("%.04f MB", BytesToMB(ClassTree.GetTotalBytes(Index, EMemColumn::SharedSysMem))); ImGui::NextColumn(); }
+				if (ShowCols.GetShowCol(EColumnTypes::SharedVidMem)) { ImGui::Text("%.04f MB", BytesToMB(ClassTree.GetTotalBytes(Index, EMemColumn::SharedVidMem))); ImGui::NextColumn(); }
+				if (ShowCols.GetShowCol(EColumnTypes::RetainedMem)) { DrawRetainedBytesCell(DominatorTree.GetGroupRetainedBytes(Index)); ImGui::NextColumn(); }
+				if (ShowCols.GetShowCol(EColumnTypes::Growth))
+				{
+					if (ClassGrowthTracker.HasSamples(Index))
+					{
+						ClassGrowthTracker.DrawCountSparkline(Index, 50.0f);
+						ImGui::SameLine();
+						ImGui::Text("%+.01f/m", ClassGrowthTracker.GetSlope(Index));
+						if (ImGui::IsItemHovered())
+						{
+							ImGui::SetTooltip("Self instances: %d\nSlope: %+.02f instances/min%s", ClassGrowthTracker.GetCountSample(Index, 0), ClassGrowthTracker.GetSlope(Index), ClassGrowthTracker.IsLeakSuspect(Index) ? "\nLEAK SUSPECT: count kept growing over the leak window" : "");
+						}
+					}
+					ImGui::NextColumn();
+				}
+				ImGui::Separator();
+			}
+		}
+
+		return true;
+	}
+
+	void DrawHoveredItemInstanceTooltip(UObject* InstanceObject)
+	{
+		ImGui::BeginTooltip();
+		if (IsValid(InstanceObject))
+		{
+			ImGui::Text("        Object: %s", Ansi(*GetNameSafe(InstanceObject)));
+			ImGui::Text("         Outer: %s", Ansi(*GetNameSafe(InstanceObject->GetOuter())));
+			ImGui::Text("default SubObj: %d", InstanceObject->IsDefaultSubobject());
+		}
+		else
+		{
+			ImGui::Text(" Invalid / Stale Object!");
 		}
 
 		ImGui::EndTooltip();
 	}
 
-	void DrawObjectInspectorPopup(FInstanceInspectorInfo& InstInspInfo, float DeltaTime)
+	void DrawObjectInspectorPopup(FInstanceInspectorInfo& InstInspInfo, float DeltaTime)
+	{
+		static EResourceSizeMode::Type ResourceSizeMode = EResourceSizeMode::EstimatedTotal;
+		ImGui::Text("%s", Ansi(*InstInspInfo.Class->GetName()));
+		ImGui::SameLine();
+		if (ImGui::SmallButton("Update Instance Memory Data"))
+		{
+			InstInspInfo.UpdateObjectMemoryInfo(false, ResourceSizeMode);
+		}
+		
+		ImGui::SameLine(0.0f, 50.0f);
+
+		static int ResourceSizeModeComboValue = static_cast<int>(ResourceSizeMode);
+		ImGui::BeginChild("ResourceSizeModeCombo", ImVec2(230.0f, 18.0f));
+		ImGui::Combo("##ResourceSizeModeCombo", &ResourceSizeModeComboValue, "Exclusive\0Estimated Total");
+		ResourceSizeMode = static_cast<EResourceSizeMode::Type>(ResourceSizeModeComboValue);
+		ImGui::EndChild();
+
+		// Top N changes re-gather from the shared object buckets, and the count is applied once the drag is released.
+		bool bTopNChanged = ImGui::Checkbox("Top N", &InstInspInfo.bTopNMode);
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::SetTooltip("Only keep the N largest instances by the sort column. Totals still cover every instance.");
+		}
+		if (InstInspInfo.bTopNMode)
+		{
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(80.0f);
+			ImGui::DragInt("##TopN", &InstInspInfo.TopN, 1.0f, 1, 100000);
+			bTopNChanged |= ImGui::IsItemDeactivatedAfterEdit();
+		}
+		if (bTopNChanged || InstInspInfo.NeedsTopNRegather())
+		{
+			InstInspInfo.UpdateObjectMemoryInfo(false, ResourceSizeMode);
+		}
+		ImGui::SameLine(0.0f, 30.0f);
+		ImGui::SetNextItemWidth(150.0f);
+		int GroupingComboValue = static_cast<int>(InstInspInfo.Grouping);
+		if (ImGui::Combo("Group By", &GroupingComboValue, InstanceGroupingComboItems))
+		{
+			InstInspInfo.Grouping = static_cast<EInstanceGrouping::Type>(GroupingComboValue);
+		}
+
+		ImGui::Checkbox("Auto-Update", &InstInspInfo.bAutoRefresh);
+		if (InstInspInfo.bAutoRefresh)
+		{
+			ImGui::SameLine(); ImGui::DragFloat("Interval", &InstInspInfo.AutoRefreshTime, 0.01f, 0.01f, 10.0f);
+			ImGui::SameLine(); ImGui::ProgressBar(FMath::Clamp<float>(InstInspInfo.AutoRefreshTimer / InstInspInfo.AutoRefreshTime, 0.0f, 1.0f));
+
+			InstInspInfo.AutoRefreshTimer -= DeltaTime;
+
+			if (InstInspInfo.AutoRefreshTimer <= 0.0f)
+			{
+				InstInspInfo.AutoRefreshTimer = InstInspInfo.AutoRefreshTime;
+				InstInspInfo.UpdateObjectMemoryInfo(false, ResourceSizeMode);
+			}
+		}
+		ImGui::Separator();
+		ImGui::Columns(2);
+		ImGui::SetColumnWidth(0, 330.0f);
+		ImGui::Text("Include/Sort:");
+		ImGui::BeginChild("IncSort", ImVec2(0.0f, 90.0f));
+		ImGui::Columns(2);
+		static const float RadWidth = 54.0f;
+		ImGui::SameLine(27.0f);
+		if (ImGui::RadioButton("##Alpha", InstInspInfo.SortType == MemDebugUtils::EMemSortType::Alpha)) { InstInspInfo.SortBy(MemDebugUtils::EMemSortType::Alpha); } ImGui::SameLine();
+		ImGui::Text("Alpha"); ImGui::NextColumn();
+
+		ImGui::Checkbox("##IsDefaultObject", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::IsDefaultObject)); ImGui::SameLine();
+		ImGui::Text("IsDefaultObject"); 
+		ImGui::Checkbox("##Outer", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::Outer)); ImGui::SameLine();
+		ImGui::Text("Outer"); ImGui::NextColumn();
+
+		ImGui::Checkbox("##TotalMemCh", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::TotalMem)); ImGui::SameLine();
+		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::TotalMem))
+		{ if (ImGui::RadioButton("##TotalMem", InstInspInfo.SortType == MemDebugUtils::EMemSortType::TotalMem)) { InstInspInfo.SortBy(MemDebugUtils::EMemSortType::TotalMem); } ImGui::SameLine(); }
+		else { ImGui::SameLine(RadWidth); }
+		ImGui::Text("TotalMem"); ImGui::NextColumn();
+
+		ImGui::Checkbox("##UnknownMemCh", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::UnknownMem)); ImGui::SameLine();
+		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::UnknownMem))
+		{ if (ImGui::RadioButton("##UnknownMem", InstInspInfo.SortType == MemDebugUtils::EMemSortType::UnknownMem)) { InstInspInfo.SortBy(MemDebugUtils::EMemSortType::UnknownMem); } ImGui::SameLine(); }
+		else { ImGui::SameLine(RadWidth); }
+		ImGui::Text("UnknownMem"); ImGui::NextColumn();
+
+		ImGui::Checkbox("##DedSysMemCh", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedSysMem)); ImGui::SameLine();
+		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedSysMem))
+		{ if (ImGui::RadioButton("##DedSysMem", InstInspInfo.SortType == MemDebugUtils::EMemSortType::DedSysMem)) { InstInspInfo.SortBy(MemDebugUtils::EMemSortType::DedSysMem); } ImGui::SameLine(); }
+		else { ImGui::SameLine(RadWidth); }
+		ImGui::Text("DedSysMem"); ImGui::NextColumn();
+
+		ImGui::Checkbox("##DedVidMemCh", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedVidMem)); ImGui::SameLine();
+		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedVidMem))
+		{ if (ImGui::RadioButton("##DedVidMem", InstInspInfo.SortType == MemDebugUtils::EMemSortType::DedVidMem)) { InstInspInfo.SortBy(MemDebugUtils::EMemSortType::DedVidMem); } ImGui::SameLine(); }
+		else { ImGui::SameLine(RadWidth); }
+		ImGui::Text("DedVidMem"); ImGui::NextColumn();
+
+		ImGui::Checkbox("##SharedSysMemCh", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedSysMem)); ImGui::SameLine();
+		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedSysMem))
+		{ if (ImGui::RadioButton("##SharedSysMem", InstInspInfo.SortType == MemDebugUtils::EMemSortType::SharedSysMem)) { InstInspInfo.SortBy(MemDebugUtils::EMemSortType::SharedSysMem); } ImGui::SameLine(); }
+		else { ImGui::SameLine(RadWidth); }
+		ImGui::Text("SharedSysMem"); ImGui::NextColumn();
+
+		ImGui::Checkbox("##SharedVidMemCh", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedVidMem)); ImGui::SameLine();
+		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedVidMem))
+		{ if (ImGui::RadioButton("##SharedVidMem", InstInspInfo.SortType == MemDebugUtils::EMemSortType::SharedVidMem)) { InstInspInfo.SortBy(MemDebugUtils::EMemSortType::SharedVidMem); } ImGui::SameLine(); }
+		else { ImGui::SameLine(RadWidth); }
+		ImGui::Text("SharedVidMem"); ImGui::NextColumn();
+
+		ImGui::Columns(1);
+		ImGui::EndChild(); // "IncSort"
+		ImGui::SetColumnWidth(1, 330.0f);
+
+
+		ImGui::NextColumn();
+		if (InstInspInfo.NameFilter.Draw("Name Filter", ImGui::GetColumnWidth() - 100.0f))
+		{
+			InstInspInfo.bVisibleIndicesDirty = true;
+		}
+		ImGui::Columns(1);
+		ImGui::BeginChild("InstLabel", ImVec2(0, 50.0f), true);
+
+		ImGui::Text("Total Instances: %d    Total Size: % .04fMB", InstInspInfo.Instances, InstInspInfo.MemInfo.TotalMemoryMB);
+		ImGui::Separator();
+
+		static constexpr int ColumnCount = 11;
+		InstInspInfo.ShowCols.GetShowCol(EColumnTypes::Instances) = false; // gross: Instances is disabled for this view so ensure it is off so CacheColCount() is contextually correct
+		InstInspInfo.ShowCols.GetShowCol(EColumnTypes::RetainedMem) = bRetainedSizeMode;
+		InstInspInfo.ShowCols.GetShowCol(EColumnTypes::Growth) = false;
+		const int VisibleColCount = InstInspInfo.ShowCols.CacheShowColCount() + 1;
+		ImGui::Columns(VisibleColCount, "ObjInstCol");
+		static float ColumnWidths[ColumnCount];
+		static constexpr float InfoColWidth = 110.0f;
+		ColumnWidths[0] = ImGui::GetWindowWidth() - (InfoColWidth * (VisibleColCount - 1)); // Object col
+		if (VisibleColCount > 1)
+		{
+			for (int i = 0; i < VisibleColCount; ++i)
+			{
+				if (i > 0)
+				{
+					ColumnWidths[i] = InfoColWidth;
+				}
+				ImGui::SetColumnWidth(i, ColumnWidths[i]);
+			}
+		}
+		ImGui::Text("Object"); ImGui::NextColumn();
+		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::IsDefaultObject)) { ImGui::Text("Is Default Obj"); ImGui::NextColumn(); }
+		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::Outer)) { ImGui::Text("Outer"); ImGui::NextColumn(); }
+		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::TotalMem)) { ImGui::Text("Total Mem"); ImGui::NextColumn(); }
+		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::UnknownMem)) { ImGui::Text("Unknown Mem"); ImGui::NextColumn(); }
+		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedSysMem)) { ImGui::Text("DedSys Mem"); ImGui::NextColumn(); }
+		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedVidMem)) { ImGui::Text("DedVid Mem"); ImGui::NextColumn(); }
+		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedSysMem)) { ImGui::Text("SharedSys Mem"); ImGui::NextColumn(); }
+		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedVidMem)) { ImGui::Text("SharedVid Mem"); ImGui::NextColumn(); }
+		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::RetainedMem)) { ImGui::Text("Retained Mem"); ImGui::NextColumn(); }
+		ImGui::Columns(1);
+		ImGui::EndChild();	  // "InstLabel"
+
+		if (ImGui::CollapsingHeader("All Instances", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			ImGui::BeginChild("InstInfo", ImVec2(0, 360.0f), true);
+			if (InstInspInfo.Grouping != EInstanceGrouping::None)
+			{
+				InstInspInfo.UpdateGroupTree();
+				InstInspInfo.GroupTree.Draw("Inspect", [&InstInspInfo](int32 InstanceIndex)
+				{
+					if (InstInspInfo.InstanceInfos.IsValidIndex(InstanceIndex))
+					{
+						InstInspInfo.InspectedInstance.SetInpectedInstance(InstInspInfo.InstanceInfos[InstanceIndex].InstanceWkPtr);
+					}
+				});
+			}
+			else
+			{
+				ImGui::Columns(VisibleColCount, "ObjInstCol");
+				if (VisibleColCount > 1)
+				{
+					for (int i = 0; i < VisibleColCount; ++i)
+					{
+						ImGui::SetColumnWidth(i, ColumnWidths[i]);
+					}
+				}
+				InstInspInfo.UpdateVisibleIndices();
+				ImGuiListClipper Clipper;
+				Clipper.Begin(InstInspInfo.VisibleIndices.Num());
+				while (Clipper.Step())
+				{
+					for (int RowIndex = Clipper.DisplayStart; RowIndex < Clipper.DisplayEnd; ++RowIndex)
+					{
+						const int32 InstanceIndex = InstInspInfo.VisibleIndices[RowIndex];
+						const FInstanceInspectorInstanceInfo& InspInstance = InstInspInfo.InstanceInfos[InstanceIndex];
+						UObject* InstanceRawPtr = InspInstance.InstanceWkPtr.Get();
+						if (InstanceRawPtr != nullptr)
+						{
+							ImGui::PushID(InstanceIndex);
+							if (ImGui::SmallButton("Inspect"))
+							{
+								InstInspInfo.InspectedInstance.SetInpectedInstance(InspInstance.InstanceWkPtr);
+							}
+							ImGui::PopID();
+							ImGui::SameLine();
+							ImGui::Text("%s", InspInstance.GetUtf8Name());
+							if (ImGui::IsItemHovered())
+							{
+								DrawHoveredItemInstanceTooltip(InstanceRawPtr);
+							}
+							ImGui::NextColumn();
+
+							if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::IsDefaultObject)) { ImGui::Text(InspInstance.bDefaultSubobject ? "true" : "false"); ImGui::NextColumn(); }
+							if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::Outer)) { 
+								ImGui::Text("%s", InspInstance.GetUtf8OuterName()); 
+								if (ImGui::IsItemHovered())
+								{
+									DrawHoveredItemInstanceTooltip(InstanceRawPtr);
+								}
+						
+								ImGui::NextColumn(); 
+							}
+						}
+						else
+						{
+							ImGui::Text("STALE/INVALID PTR"); ImGui::NextColumn();
+							if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::IsDefaultObject)) { ImGui::NextColumn(); }
+							if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::Outer)) { ImGui::NextColumn(); }
+						}
+				
+						if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::TotalMem)) { ImGui::Text("%.04f MB", InspInstance.MemInfo.TotalMemoryMB); ImGui::NextColumn(); }
+						if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::UnknownMem)) { ImGui::Text("%.04f MB", InspInstance.MemInfo.UnknownMemoryMB); ImGui::NextColumn(); }
+						if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedSysMem)) { ImGui::Text("%.04f MB", InspInstance.MemInfo.DedSysMemoryMB); ImGui::NextColumn(); }
+						if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedVidMem)) { ImGui::Text("%.04f MB", InspInstance.MemInfo.DedVidMemoryMB); ImGui::NextColumn(); }
+						if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedSysMem)) { ImGui::Text("%.04f MB", InspInstance.MemInfo.SharedSysMemoryMB); ImGui::NextColumn(); }
+						if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedVidMem)) { ImGui::Text("%.04f MB", InspInstance.MemInfo.SharedVidMemoryMB); ImGui::NextColumn(); }
+						if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::RetainedMem)) { DrawRetainedBytesCell(DominatorTree.GetRetainedBytes(ReferenceGraph.FindNode(InstanceRawPtr))); ImGui::NextColumn(); }
+					}
+				}
+				ImGui::Columns(1);
+			}
+			ImGui::EndChild(); // "InstInfo"
+		}
+
+		if (ImGui::CollapsingHeader("Inspected Instance", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			ImGui::BeginChild("InspectedInstance", ImVec2(0, 440.0f), true);
+
+			UObject* InspectedInstanceRawPtr = InstInspInfo.InspectedInstance.InspectedWkPtr.Get();
+			if (IsValid(InspectedInstanceRawPtr))
+			{
+				ImGui::Text("        Object: %s (%p)", Ansi(*GetNameSafe(InspectedInstanceRawPtr)), InspectedInstanceRawPtr);
+				ImGui::Text("         Class: %s", Ansi(*GetNameSafe(InspectedInstanceRawPtr->GetClass())));
+				ImGui::Text("         World: %s (%p)", Ansi(*GetNameSafe(InspectedInstanceRawPtr->GetWorld())), InspectedInstanceRawPtr->GetWorld());
+				ImGui::Text("         Outer: %s", Ansi(*GetNameSafe(InspectedInstanceRawPtr->GetOuter())));
+				ImGui::Text("default SubObj: %d", InspectedInstanceRawPtr->IsDefaultSubobject());
+				if (HasRetainedSizes())
+				{
+					ImGui::Text("      Retained: %.04f MB", BytesToMB(DominatorTree.GetRetainedBytes(ReferenceGraph.FindNode(InspectedInstanceRawPtr))));
+				}
+
+				const ImGuiTools::Utils::FObjectReferenceGraph::EState GraphState = ReferenceGraph.GetState();
+				if ((GraphState == ImGuiTools::Utils::FObjectReferenceGraph::EState::Collecting) || (GraphState == ImGuiTools::Utils::FObjectReferenceGraph::EState::Finalizing))
+				{
+					const bool bCollecting = (GraphState == ImGuiTools::Utils::FObjectReferenceGraph::EState::Collecting);
+					ImGui::ProgressBar(ReferenceGraph.GetProgress(), ImVec2(200.0f, 0.0f), bCollecting ? "Collecting references..." : "Indexing referencers...");
+					ImGui::SameLine();
+					ImGui::SetNextItemWidth(100.0f);
+					ImGui::DragFloat("ms/frame##RefGraphBudget", &ReferenceGraphBudgetMs, 0.1f, 0.5f, 50.0f, "%.1f");
+				}
+				else if (ImGui::Button("Refresh Reference Graph"))
+				{
+					ReferenceGraph.BeginRefresh();
+					InstInspInfo.InspectedInstance.UpdateInspectedInstanceReferencers();
+				}
+				InstInspInfo.InspectedInstance.PullReferencersFromGraph();
+				InstInspInfo.InspectedInstance.UpdateRetentionPath();
+
+				if (InstInspInfo.InspectedInstance.bRetentionRequested)
+				{
+					ImGui::Text("Explain retention: %s", ReferenceGraph.IsReady() ? "searching for the shortest path from a GC root..." : "waiting for the reference graph...");
+				}
+				else if (ImGui::Button("Explain retention"))
+				{
+					InstInspInfo.InspectedInstance.RequestRetentionPath();
+				}
+
+				if (InstInspInfo.InspectedInstance.bRetentionSearched)
+				{
+					const TArray<FRetentionHopInfo>& RetentionPath = InstInspInfo.InspectedInstance.RetentionPath;
+					if (InstInspInfo.InspectedInstance.bRetentionNotInGraph)
+					{
+						ImGui::Text("The instance is not in the current reference graph snapshot, refresh the graph and try again.");
+					}
+					else if (RetentionPath.Num() == 0)
+					{
+						ImGui::Text("No path from a GC root in the reference graph, the instance should be collected by the next GC.");
+					}
+					else
+					{
+						ImGui::BeginChild("RetentionPath", ImVec2(0, FMath::Min(20.0f + (RetentionPath.Num() * ImGui::GetTextLineHeightWithSpacing()), 200.0f)), true);
+						for (int i = 0; i < RetentionPath.Num(); ++i)
+						{
+							const FRetentionHopInfo& HopInfo = RetentionPath[i];
+							UObject* HopRawPtr = HopInfo.ObjectWkPtr.Get();
+							const char* RootReason = "";
+							if (HopInfo.bRoot && IsValid(HopRawPtr))
+							{
+								RootReason = HopRawPtr->IsRooted() ? " [root set]" : (GUObjectArray.IsDisregardForGC(HopRawPtr) ? " [disregard for GC]" : " [standalone]");
+							}
+
+							ImGui::Text("%02d: %s (%s)%s", i, Ansi(*GetNameSafe(HopRawPtr)), Ansi(*GetNameSafe(IsValid(HopRawPtr) ? HopRawPtr->GetClass() : nullptr)), RootReason);
+							if (ImGui::IsItemHovered() && IsValid(HopRawPtr))
+							{
+								DrawHoveredItemInstanceTooltip(HopRawPtr);
+							}
+							if (i < RetentionPath.Num() - 1)
+							{
+								ImGui::Text("      -> %s", HopInfo.PropertyName.IsEmpty() ? "(native reference)" : Ansi(*HopInfo.PropertyName));
+							}
+						}
+						ImGui::EndChild(); // "RetentionPath"
+					}
+				}
+
+				const auto DrawReferencers = [](const TArray<FReferencerInfo>& CachedReferencerInfo, const char* ChildId)
+				{
+					static constexpr int RefInfoColumnCount = 4;
+					ImGui::Columns(RefInfoColumnCount);
+					ImGui::Text("Name"); ImGui::NextColumn();
+					ImGui::Text("Class"); ImGui::NextColumn();
+					ImGui::Text("World"); ImGui::NextColumn();
+					ImGui::Text("Properties"); ImGui::NextColumn();
+					ImGui::Columns(1);
+
+					ImGui::BeginChild(ChildId, ImVec2(0, 200.0f), true);
+					ImGui::Columns(RefInfoColumnCount);
+
+					int RefIter = 0;
+					for (const FReferencerInfo& ReferencerInfo : CachedReferencerInfo)
+					{
+						UObject* ReferencerRawPtr = ReferencerInfo.ReferencerWkPtr.Get();
+						ImGui::Text("%03d: %s(%p) (refs: %d)", ++RefIter, Ansi(*GetNameSafe(ReferencerRawPtr)), ReferencerRawPtr, ReferencerInfo.TotalReferences); ImGui::NextColumn();
+
+						if (IsValid(ReferencerRawPtr))
+						{
+							ImGui::Text("%s", Ansi(*GetNameSafe(ReferencerRawPtr->GetClass()))); ImGui::NextColumn();
+							ImGui::Text("%s", Ansi(*GetNameSafe(ReferencerRawPtr->GetWorld()))); ImGui::NextColumn();
+							for (int i = 0; i < ReferencerInfo.ReferencingProperties.Num(); ++i)
+							{
+								const FString& RefPropName = ReferencerInfo.ReferencingProperties[i];
+								ImGui::Text("%02d: %s", (i+1), Ansi(*RefPropName));
+							}
+							ImGui::NextColumn();
+						}
+						else
+						{
+							ImGui::Text("*invalid*"); ImGui::NextColumn();
+							ImGui::Text("*invalid*"); ImGui::NextColumn();
+							ImGui::Text("*invalid*"); ImGui::NextColumn();
+						}
+					}
+
+					ImGui::Columns(1);
+					ImGui::EndChild();
+				};
+
+
+				const FString& InternalRefHeader = FString::Printf(TEXT("Internal Referencers count: %d"), InstInspInfo.InspectedInstance.CachedInternalReferencers.Num());
+				const FString& ExternalRefHeader = FString::Printf(TEXT("External Referencers count: %d"), InstInspInfo.InspectedInstance.CachedExternalReferencers.Num());
+				if (ImGui::CollapsingHeader(Ansi(*InternalRefHeader)))
+				{
+					DrawReferencers(InstInspInfo.InspectedInstance.CachedInternalReferencers, "InternalReferencers");
+				}
+				if (ImGui::CollapsingHeader(Ansi(*ExternalRefHeader), ImGuiTreeNodeFlags_DefaultOpen))
+				{
+					DrawReferencers(InstInspInfo.InspectedInstance.CachedExternalReferencers, "ExternalReferencers");
+				}
+			}
+			else
+			{
+				ImGui::Text("Inspected Instance Invalid / Stale / Null - Please select an instance in the list above.");
+			}
+
+			ImGui::EndChild(); // "InspectedInstance"
+		}
+	}
+
+	///////////////////////////////////////
+	/////////  Texture Memory Snapshot
+	//	Gathering texture usage means asking every primitive component for its streaming render assets, which is far too slow to do
+	//	every frame on a large map. The gather is cached in a snapshot instead: the component pass is time-sliced across frames under a
+	//	per-frame budget, then the (much cheaper) texture pass runs once and the list is only filtered and sorted again when the view changes.
+
+	namespace ETextureListMode
+	{
+		enum Type
+		{
+			All,
+			Streaming,
+			NonStreaming,
+			Forced,
+			Unreferenced
+		};
+	}	// namespace ETextureListMode
+
+	struct FTextureSnapshot
+	{
+		// Display strings of a texture row, pre-formatted once per snapshot so drawing a row never formats or converts anything.
+		enum class EDisplayString : uint8
+		{
+			OnDisk,
+			InMem,
+			Format,
+			LODGroup,
+			Name,
+			Num
+		};
+
+		struct FDisplayStrings
+		{
+			int32 Offsets[(int32)EDisplayString::Num];	// into StringBlob
+		};
+
+		bool IsGathering() const
+		{
+			return bGathering;
+		}
+
+		bool HasSnapshot() const
+		{
+			return SnapshotTime > 0.0;
+		}
+
+		float GetGatherProgress() const
+		{
+			return (Components.Num() > 0) ? ((float)ComponentCursor / (float)Components.Num()) : 1.0f;
+		}
+
+		double GetSnapshotAge() const
+		{
+			return FPlatformTime::Seconds() - SnapshotTime;
+		}
+
+		void BeginGather()
+		{
+			if (bGathering)
+			{
+				return;
+			}
+
+			bGatherCancelled = false;
+			GatherStartTime = FPlatformTime::Seconds();
+			GatherTextureIds.Reset();
+			GatherUsageCounts.Reset();
+			GatherUsagePairs.Reset();
+			Components.Reset();
+			ComponentCursor = 0;
+
+			TArray<UObject*> ComponentObjects;
+			GetObjectsOfClass(UPrimitiveComponent::StaticClass(), ComponentObjects, true, RF_ClassDefaultObject);
+			Components.Reserve(ComponentObjects.Num());
+			for (UObject* ComponentObject : ComponentObjects)
+			{
+				Components.Add(static_cast<UPrimitiveComponent*>(ComponentObject));
+			}
+
+			bGathering = true;
+		}
+
+		// Also stops auto refreshes from starting a new gather until BeginGather() is called again, i.e. Refresh is pressed.
+		void CancelGather()
+		{
+			bGathering = false;
+			bGatherCancelled = true;
+			Components.Reset();
+			GatherTextureIds.Reset();
+			GatherUsageCounts.Reset();
+			GatherUsagePairs.Reset();
+		}
+
+		// Called every frame from the tool update. Starts auto refreshes while the list is being looked at, and progresses the
+		//	component pass by up to GatherBudgetMs.
+		void Tick()
+		{
+			const bool bViewed = (GFrameCounter - LastViewFrame) <= 1;
+			if (!bGathering && !bGatherCancelled && bViewed && (!HasSnapshot() || (bAutoRefresh && (GetSnapshotAge() > RefreshInterval))))
+			{
+				BeginGather();
+			}
+
+			if (!bGathering)
+			{
+				return;
+			}
+
+			const double SliceEndTime = FPlatformTime::Seconds() + (GatherBudgetMs / 1000.0);
+			while (ComponentCursor < Components.Num())
+			{
+				const int32 ComponentIndex = ComponentCursor++;
+				if (UPrimitiveComponent* PrimitiveComponent = Components[ComponentIndex].Get())
+				{
+					GatherComponentUsage(PrimitiveComponent, ComponentIndex);
+				}
+
+				if (((ComponentCursor & 0x1F) == 0) && (FPlatformTime::Seconds() > SliceEndTime))
+				{
+					return;
+				}
+			}
+
+			FinishGather();
+		}
+
+		// Find out how many primitive components reference a texture, and remember which ones for the reverse usage index.
+		void GatherComponentUsage(UPrimitiveComponent* PrimitiveComponent, int32 ComponentIndex)
+		{
+			// Use the existing texture streaming functionality to gather referenced textures. Worth noting
+			// that GetStreamingTextureInfo doesn't check whether a texture is actually streamable or not
+			// and is also implemented for skeletal meshes and such.
+#if ENGINE_MAJOR_VERSION == 4
+			ImGuiDebugToolsUtils::FStreamingTextureLevelContext LevelContext(EMaterialQualityLevel::Num, PrimitiveComponent);
+#elif ENGINE_MAJOR_VERSION == 5
+			FStreamingTextureLevelContext LevelContext(EMaterialQualityLevel::Num, PrimitiveComponent);
+#endif
+			TArray<FStreamingRenderAssetPrimitiveInfo> StreamingTextures;
+			PrimitiveComponent->GetStreamingRenderAssetInfo((FStreamingTextureLevelContext&)LevelContext, StreamingTextures);
+
+			//// Increase usage count for all referenced textures
+			for (int32 TextureIndex = 0; TextureIndex < StreamingTextures.Num(); TextureIndex++)
+			{
+				UTexture2D* Texture = Cast<UTexture2D>(StreamingTextures[TextureIndex].RenderAsset);
+				if (Texture)
+				{
+					int32 TextureId = INDEX_NONE;
+					if (const int32* FoundId = GatherTextureIds.Find(Texture))
+					{
+						TextureId = *FoundId;
+					}
+					else
+					{
+						TextureId = GatherUsageCounts.Add(0);
+						GatherTextureIds.Add(Texture, TextureId);
+					}
+					++GatherUsageCounts[TextureId];
+					GatherUsagePairs.Add({ TextureId, ComponentIndex });
+				}
+			}
+		}
+
+		void FinishGather()
+		{
+			bGathering = false;
+
+			// Group the usage pairs by texture, then by component so duplicates (a component using a texture through several
+			//	materials) are adjacent.
+			GatherUsagePairs.Sort([](const FUsagePair& LHS, const FUsagePair& RHS)
+			{
+				return (LHS.TextureId != RHS.TextureId) ? (LHS.TextureId < RHS.TextureId) : (LHS.ComponentIndex < RHS.ComponentIndex);
+			});
+			TArray<int32> TextureIdPairStarts;
+			TextureIdPairStarts.Init(0, GatherUsageCounts.Num() + 1);
+			for (const FUsagePair& UsagePair : GatherUsagePairs)
+			{
+				++TextureIdPairStarts[UsagePair.TextureId + 1];
+			}
+			for (int32 i = 1; i < TextureIdPairStarts.Num(); ++i)
+			{
+				TextureIdPairStarts[i] += TextureIdPairStarts[i - 1];
+			}
+
+			NumApplicableToMinSize = 0;
+			Textures.Reset();
+			UsageStarts.Reset();
+			UsageComponents.Reset();
+			for (TObjectIterator<UTexture> It; It; ++It)
+			{
+				UTexture* Texture = *It;
+				UTexture2D* Texture2D = Cast<UTexture2D>(Texture);
+				UTextureCube* TextureCube = Cast<UTextureCube>(Texture);
+				UsageStarts.Add(UsageComponents.Num());
+
+				int32 LODGroup = Texture->LODGroup;
+				int32 NumMips = 0;
+				int32 MaxResLODBias = 0;
+				int32 MaxAllowedSizeX = 0;
+				int32 MaxAllowedSizeY = 0;
+				EPixelFormat Format = PF_Unknown;
+				int32 DroppedMips = 0;
+				int32 CurSizeX = 0;
+				int32 CurSizeY = 0;
+				bool bIsStreamingTexture = false;
+				int32 MaxAllowedSize = Texture->CalcTextureMemorySizeEnum(TMC_AllMipsBiased);
+				int32 CurrentSize = Texture->CalcTextureMemorySizeEnum(TMC_ResidentMips);
+				int32 UsageCount = 0;
+				bool bIsForced = false;
+
+				if (Texture2D != nullptr)
+				{
+					NumMips = Texture2D->GetNumMips();
+					MaxResLODBias = NumMips - Texture2D->GetNumMipsAllowed(false);
+					MaxAllowedSizeX = FMath::Max<int32>(Texture2D->GetSizeX() >> MaxResLODBias, 1);
+					MaxAllowedSizeY = FMath::Max<int32>(Texture2D->GetSizeY() >> MaxResLODBias, 1);
+					Format = Texture2D->GetPixelFormat();
+					DroppedMips = Texture2D->GetNumMips() - Texture2D->GetNumResidentMips();
+					CurSizeX = FMath::Max<int32>(Texture2D->GetSizeX() >> DroppedMips, 1);
+					CurSizeY = FMath::Max<int32>(Texture2D->GetSizeY() >> DroppedMips, 1);
+					bIsStreamingTexture = Texture2D->GetStreamingIndex() != INDEX_NONE;
+					if (const int32* TextureId = GatherTextureIds.Find(Texture2D))
+					{
+						UsageCount = GatherUsageCounts[*TextureId];
+
+						int32 LastComponentIndex = INDEX_NONE;
+						for (int32 PairIndex = TextureIdPairStarts[*TextureId]; PairIndex < TextureIdPairStarts[*TextureId + 1]; ++PairIndex)
+						{
+							const int32 ComponentIndex = GatherUsagePairs[PairIndex].ComponentIndex;
+							if (ComponentIndex != LastComponentIndex)
+							{
+								UsageComponents.Add(Components[ComponentIndex]);
+								LastComponentIndex = ComponentIndex;
+							}
+						}
+					}
+					bIsForced = Texture2D->ShouldMipLevelsBeForcedResident() && bIsStreamingTexture;
+
+					if ((NumMips >= Texture2D->GetMinTextureResidentMipCount()) && bIsStreamingTexture)
+					{
+						NumApplicableToMinSize++;
+					}
+				}
+				else if (TextureCube != nullptr)
+				{
+					NumMips = TextureCube->GetNumMips();
+					Format = TextureCube->GetPixelFormat();
+				}
+
+				FSortedTexture& SortedTexture = Textures.Emplace_GetRef(MaxAllowedSizeX, MaxAllowedSizeY, Format, CurSizeX, CurSizeY, MaxResLODBias, MaxAllowedSize, CurrentSize,
+																		Texture->GetPathName(), LODGroup, bIsStreamingTexture, UsageCount);
+				SortedTexture.bIsForced = bIsForced;
+				SortedTexture.bUsageTracked = (Texture2D != nullptr);
+				SortedTexture.SizeX = (Texture2D != nullptr) ? Texture2D->GetSizeX() : 0;
+				SortedTexture.SizeY = (Texture2D != nullptr) ? Texture2D->GetSizeY() : 0;
+				SortedTexture.NumMips = NumMips;
+				SortedTexture.Texture = Texture;
+			}
+			UsageStarts.Add(UsageComponents.Num());
+			Components.Reset();
+			GatherTextureIds.Reset();
+			GatherUsageCounts.Reset();
+			GatherUsagePairs.Reset();
+			BuildDisplayStrings();
+			UpdateBudgetTotals();
+
+			SnapshotTime = FPlatformTime::Seconds();
+			LastGatherDurationMs = (SnapshotTime - GatherStartTime) * 1000.0;
+			++SnapshotVersion;
+		}
+
+		int32 AddDisplayString(const TCHAR* String)
+		{
+			const int32 Offset = StringBlob.Num();
+			AppendUtf8(StringBlob, String);
+			StringBlob.Add('\0');
+			return Offset;
+		}
+
+		const ANSICHAR* GetDisplayString(int32 TextureIndex, EDisplayString String) const
+		{
+			return StringBlob.GetData() + DisplayStrings[TextureIndex].Offsets[(int32)String];
+		}
+
+		void BuildDisplayStrings()
+		{
+			StringBlob.Reset();
+			DisplayStrings.Reset(Textures.Num());
+
+			// Retrieve mapping from LOD group enum value to text representation. Group and format names are shared by every row.
+			TextureGroupNames = UTextureLODSettings::GetTextureGroupNames();
+			TArray<int32> LODGroupOffsets;
+			for (const FString& GroupName : TextureGroupNames)
+			{
+				LODGroupOffsets.Add(AddDisplayString(*GroupName));
+			}
+			const int32 InvalidLODGroupOffset = AddDisplayString(TEXT("INVALID"));
+
+			TArray<int32> FormatOffsets;
+			FormatOffsets.Init(INDEX_NONE, PF_MAX);
+
+			const bool bCookedData = FPlatformProperties::RequiresCookedData();
+			for (const FSortedTexture& SortedTexture : Textures)
+			{
+				FDisplayStrings& Strings = DisplayStrings.AddDefaulted_GetRef();
+
+				const FString AuthoredBiasString = bCookedData ? FString(TEXT("?")) : FString::FromInt(SortedTexture.LODBias);
+				Strings.Offsets[(int32)EDisplayString::OnDisk] = AddDisplayString(*FString::Printf(TEXT(" %i KB, %s- %ix%i"), (SortedTexture.MaxAllowedSize + 512) / 1024, *AuthoredBiasString, SortedTexture.MaxAllowedSizeX, SortedTexture.MaxAllowedSizeY));
+				Strings.Offsets[(int32)EDisplayString::InMem] = AddDisplayString(*FString::Printf(TEXT("%i KB- %ix%i"), (SortedTexture.CurrentSize + 512) / 1024, SortedTexture.CurSizeX, SortedTexture.CurSizeY));
+
+				const int32 FormatIndex = FMath::Clamp<int32>(SortedTexture.Format, 0, PF_MAX - 1);
+				if (FormatOffsets[FormatIndex] == INDEX_NONE)
+				{
+					FormatOffsets[FormatIndex] = AddDisplayString(GetPixelFormatString((EPixelFormat)FormatIndex));
+				}
+				Strings.Offsets[(int32)EDisplayString::Format] = FormatOffsets[FormatIndex];
+				Strings.Offsets[(int32)EDisplayString::LODGroup] = LODGroupOffsets.IsValidIndex(SortedTexture.LODGroup) ? LODGroupOffsets[SortedTexture.LODGroup] : InvalidLODGroupOffset;
+				Strings.Offsets[(int32)EDisplayString::Name] = AddDisplayString(*SortedTexture.Name);
+			}
+		}
+
+		// Filter and sort the cached textures for the list mode and name filter, only when the snapshot or the view settings changed.
+		void UpdateVisibleTextures(ETextureListMode::Type Mode, bool bAlphaSort)
+		{
+			if ((VisibleSnapshotVersion == SnapshotVersion) && (VisibleMode == Mode) && (bVisibleAlphaSort == bAlphaSort) && !bNameFilterDirty)
+			{
+				return;
+			}
+			VisibleSnapshotVersion = SnapshotVersion;
+			VisibleMode = Mode;
+			bVisibleAlphaSort = bAlphaSort;
+			bNameFilterDirty = false;
+
+			VisibleIndices.Reset();
+			for (int32 i = 0; i < Textures.Num(); ++i)
+			{
+				const FSortedTexture& SortedTexture = Textures[i];
+				const bool bPassesMode = ((Mode == ETextureListMode::Streaming) && SortedTexture.bIsStreaming) ||
+										 ((Mode == ETextureListMode::NonStreaming) && !SortedTexture.bIsStreaming) ||
+										 ((Mode == ETextureListMode::Forced) && SortedTexture.bIsForced) ||
+										 ((Mode == ETextureListMode::Unreferenced) && SortedTexture.IsUnreferencedResident()) ||
+										 (Mode == ETextureListMode::All);
+				if (bPassesMode && (!NameFilter.IsActive() || NameFilter.PassFilter(GetDisplayString(i, EDisplayString::Name))))
+				{
+					VisibleIndices.Add(i);
+				}
+			}
+
+			// Sort textures by cost.
+			const FCompareFSortedTexture Compare(bAlphaSort);
+			VisibleIndices.Sort([this, &Compare](int32 LHS, int32 RHS) { return Compare(Textures[LHS], Textures[RHS]); });
+
+			TotalMaxAllowedSize = 0;
+			TotalCurrentSize = 0;
+			for (int32 TextureIndex : VisibleIndices)
+			{
+				TotalMaxAllowedSize += Textures[TextureIndex].MaxAllowedSize;
+				TotalCurrentSize += Textures[TextureIndex].CurrentSize;
+			}
+		}
+
+		TArrayView<const TWeakObjectPtr<UPrimitiveComponent>> GetTextureUsers(int32 TextureIndex) const
+		{
+			return TArrayView<const TWeakObjectPtr<UPrimitiveComponent>>(UsageComponents.GetData() + UsageStarts[TextureIndex], UsageStarts[TextureIndex + 1] - UsageStarts[TextureIndex]);
+		}
+
+		void SelectTexture(int32 TextureIndex)
+		{
+			SelectedTextureIndex = TextureIndex;
+			SelectedTexture = Textures.IsValidIndex(TextureIndex) ? Textures[TextureIndex].Texture : nullptr;
+			SelectedSnapshotVersion = SnapshotVersion;
+		}
+
+		// Index of the selected texture in the current snapshot, found again by object after a refresh.
+		int32 GetSelectedTextureIndex()
+		{
+			if (SelectedSnapshotVersion != SnapshotVersion)
+			{
+				SelectedSnapshotVersion = SnapshotVersion;
+				SelectedTextureIndex = SelectedTexture.IsValid() ? Textures.IndexOfByPredicate([this](const FSortedTexture& SortedTexture) { return SortedTexture.Texture == SelectedTexture; }) : INDEX_NONE;
+			}
+			return SelectedTextureIndex;
+		}
+
+		// Per LOD group and per pixel format totals over every texture of the snapshot (ignoring the list filters), and a new
+		//	sample of the group history.
+		void UpdateBudgetTotals()
+		{
+			TextureGroupCurrentSizes.Reset();
+			TextureGroupMaxAllowedSizes.Reset();
+			FormatCurrentSizes.Reset();
+			FormatMaxAllowedSizes.Reset();
+			TextureGroupCurrentSizes.AddZeroed(TextureGroupNames.Num());
+			TextureGroupMaxAllowedSizes.AddZeroed(TextureGroupNames.Num());
+			FormatCurrentSizes.AddZeroed(PF_MAX);
+			FormatMaxAllowedSizes.AddZeroed(PF_MAX);
+
+			for (const FSortedTexture& SortedTexture : Textures)
+			{
+				if (TextureGroupNames.IsValidIndex(SortedTexture.LODGroup))
+				{
+					TextureGroupCurrentSizes[SortedTexture.LODGroup] += SortedTexture.CurrentSize;
+					TextureGroupMaxAllowedSizes[SortedTexture.LODGroup] += SortedTexture.MaxAllowedSize;
+				}
+
+				if (SortedTexture.Format >= 0 && SortedTexture.Format < PF_MAX)
+				{
+					FormatCurrentSizes[SortedTexture.Format] += SortedTexture.CurrentSize;
+					FormatMaxAllowedSizes[SortedTexture.Format] += SortedTexture.MaxAllowedSize;
+				}
+			}
+
+			const int32 NumGroups = TextureGroupNames.Num();
+			if (GroupHistoryMB.Num() != NumGroups)
+			{
+				GroupHistoryMB.Reset();
+				GroupHistoryMB.SetNum(NumGroups);
+				HistoryTimes.Reset();
+			}
+			for (int32 GroupIndex = 0; GroupIndex < NumGroups; ++GroupIndex)
+			{
+				GroupHistoryMB[GroupIndex].Push((float)((double)TextureGroupCurrentSizes[GroupIndex] / 1024. / 1024.));
+			}
+			HistoryTimes.Push(FPlatformTime::Seconds());
+		}
+
+		int32 GetNumHistorySamples() const
+		{
+			return HistoryTimes.Num();
+		}
+
+		// Sample Age steps back from the newest one (Age 0).
+		float GetGroupHistoryMB(int32 GroupIndex, int32 Age) const
+		{
+			return GroupHistoryMB[GroupIndex].Get(Age);
+		}
+
+		double GetHistoryTime(int32 Age) const
+		{
+			return HistoryTimes.Get(Age);
+		}
+
+		// Settings
+		bool bAutoRefresh = true;
+		float RefreshInterval = 10.0f;	// seconds between auto refreshes while the list is open
+		float GatherBudgetMs = 2.0f;
+		uint64 LastViewFrame = 0;		// set by the UI every frame the list is drawn, auto refreshes only happen while it is
+
+		// Gather in progress
+		bool bGathering = false;
+		bool bGatherCancelled = false;	// set by CancelGather(), suppresses auto refreshes until the next BeginGather()
+		int32 ComponentCursor = 0;
+		double GatherStartTime = 0.0;
+		TArray<TWeakObjectPtr<UPrimitiveComponent>> Components;
+		struct FUsagePair
+		{
+			int32 TextureId;		// into GatherUsageCounts
+			int32 ComponentIndex;	// into Components
+		};
+		TMap<TWeakObjectPtr<UTexture2D>, int32> GatherTextureIds;
+		TArray<int32> GatherUsageCounts;
+		TArray<FUsagePair> GatherUsagePairs;
+
+		// Snapshot
+		double SnapshotTime = 0.0;
+		double LastGatherDurationMs = 0.0;
+		uint32 SnapshotVersion = 0;
+		TArray<FSortedTexture> Textures;
+		TArray<FDisplayStrings> DisplayStrings;	// per texture
+
+		// Reverse usage index: the distinct components using each texture, grouped by texture (Textures.Num() + 1 offsets).
+		TArray<int32> UsageStarts;
+		TArray<TWeakObjectPtr<UPrimitiveComponent>> UsageComponents;
+		TArray<ANSICHAR> StringBlob;
+		TArray<FString> TextureGroupNames;
+		int32 NumApplicableToMinSize = 0;
+		TArray<uint64> TextureGroupCurrentSizes;
+		TArray<uint64> TextureGroupMaxAllowedSizes;
+		TArray<uint64> FormatCurrentSizes;
+		TArray<uint64> FormatMaxAllowedSizes;
+
+		// Resident MB per LOD group over the last snapshots, all pushed together with the snapshot time.
+		static constexpr int32 NumHistorySamples = 64;
+		TArray<TRingHistory<float, NumHistorySamples>> GroupHistoryMB;
+		TRingHistory<double, NumHistorySamples> HistoryTimes;
+
+		// Filtered and sorted view of the snapshot, with totals over the visible textures.
+		uint32 VisibleSnapshotVersion = 0;
+		ETextureListMode::Type VisibleMode = ETextureListMode::All;
+		bool bVisibleAlphaSort = false;
+		ImGuiTextFilter NameFilter;
+		bool bNameFilterDirty = false;
+		TArray<int32> VisibleIndices;
+		TWeakObjectPtr<UTexture> SelectedTexture;
+		int32 SelectedTextureIndex = INDEX_NONE;
+		uint32 SelectedSnapshotVersion = 0;
+		uint64 TotalMaxAllowedSize = 0;
+		uint64 TotalCurrentSize = 0;
+	};
+
+	FTextureSnapshot TextureSnapshot;
+
+	// Last Actor/Component Debugger link that failed to open, shown under the users list until another texture is selected.
+	FString TextureUsersOpenError;
+	int32 TextureUsersOpenErrorIndex = INDEX_NONE;
+
+	// Actors and components using the selected texture, from the snapshot's reverse usage index, with links to the Actor/Component Debugger.
+	void DrawTextureUsers(FTextureSnapshot& Snapshot)
+	{
+		const int32 TextureIndex = Snapshot.GetSelectedTextureIndex();
+		if (TextureUsersOpenErrorIndex != TextureIndex)
+		{
+			TextureUsersOpenError.Empty();
+			TextureUsersOpenErrorIndex = INDEX_NONE;
+		}
+		if (TextureIndex == INDEX_NONE)
+		{
+			ImGui::Text("Select a texture in the list to see the components using it.");
+			return;
+		}
+
+		const TArrayView<const TWeakObjectPtr<UPrimitiveComponent>> Users = Snapshot.GetTextureUsers(TextureIndex);
+		ImGui::Text("%d components using %s", Users.Num(), Snapshot.GetDisplayString(TextureIndex, FTextureSnapshot::EDisplayString::Name));
+		if (Users.Num() == 0)
+		{
+			return;
+		}
+
+		ImGui::BeginChild("TextureUsers", ImVec2(0, 200.0f), true);
+		ImGuiListClipper Clipper;
+		Clipper.Begin(Users.Num());
+		while (Clipper.Step())
+		{
+			for (int UserIndex = Clipper.DisplayStart; UserIndex < Clipper.DisplayEnd; ++UserIndex)
+			{
+				UPrimitiveComponent* Component = Users[UserIndex].Get();
+				if (Component == nullptr)
+				{
+					ImGui::Text("STALE/INVALID PTR");
+					continue;
+				}
+
+				AActor* Owner = Component->GetOwner();
+				ImGui::PushID(UserIndex);
+				if (ImGui::SmallButton("Actor"))
+				{
+					if (Owner == nullptr)
+					{
+						TextureUsersOpenError = FString::Printf(TEXT("%s has no owning actor to open."), *Component->GetName());
+						TextureUsersOpenErrorIndex = TextureIndex;
+					}
+					else if (!FImGuiActorComponentDebugger::OpenActorWindow(Owner))
+					{
+						TextureUsersOpenError = FString::Printf(TEXT("Could not open %s: its world is not tracked by the Actor/Component Debugger."), *Owner->GetName());
+						TextureUsersOpenErrorIndex = TextureIndex;
+					}
+				}
+				ImGui::SameLine();
+				if (ImGui::SmallButton("Comp") && !FImGuiActorComponentDebugger::OpenComponentWindow(Component))
+				{
+					TextureUsersOpenError = FString::Printf(TEXT("Could not open %s: its world is not tracked by the Actor/Component Debugger."), *Component->GetName());
+					TextureUsersOpenErrorIndex = TextureIndex;
+				}
+				ImGui::PopID();
+				ImGui::SameLine();
+				ImGui::Text("%s / %s", (Owner != nullptr) ? Ansi(*Owner->GetName()) : "(no owner)", Ansi(*Component->GetName()));
+			}
+		}
+		ImGui::EndChild(); // "TextureUsers"
+
+		if (!TextureUsersOpenError.IsEmpty())
+		{
+			ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", Ansi(*TextureUsersOpenError));
+		}
+	}
+
+	// Textures resident in memory that no primitive component of any world uses, with their bytes aggregated by package and by the
+	//	object keeping them alive. Keepers come from the shared reference graph (the first referencer that is not itself a texture),
+	//	so they are only known once the graph has been built.
+	struct FUnreferencedTextureReport
+	{
+		enum class EView : uint8
+		{
+			Packages,
+			Keepers,
+			Textures,
+		};
+
+		enum class ESortType : uint8
+		{
+			Bytes,
+			Count,
+			Alpha,
+		};
+
+		struct FBucket
+		{
+			TArray<ANSICHAR> Utf8Label;
+			uint64 Bytes = 0;
+			int32 NumTextures = 0;
+
+			const ANSICHAR* GetUtf8Label() const { return Utf8Label.GetData(); }
+		};
+
+		// Rebuild when the texture snapshot or the reference graph changed. Game thread only.
+		void Update(const FTextureSnapshot& Snapshot)
+		{
+			const uint32 GraphSnapshotId = ReferenceGraph.IsReady() ? ReferenceGraph.GetSnapshotId() : 0;
+			if ((SnapshotVersion == Snapshot.SnapshotVersion) && (KeeperGraphSnapshotId == GraphSnapshotId))
+			{
+				return;
+			}
+			SnapshotVersion = Snapshot.SnapshotVersion;
+			KeeperGraphSnapshotId = GraphSnapshotId;
+
+			TextureIndices.Reset();
+			TextureKeepers.Reset();
+			PackageBuckets.Reset();
+			KeeperBuckets.Reset();
+			ReclaimableBytes = 0;
+
+			TMap<FString, int32> PackageToBucket;
+			TMap<const UObject*, int32> KeeperToBucket;
+			for (int32 TextureIndex = 0; TextureIndex < Snapshot.Textures.Num(); ++TextureIndex)
+			{
+				const FSortedTexture& SortedTexture = Snapshot.Textures[TextureIndex];
+				if (!SortedTexture.IsUnreferencedResident())
+				{
+					continue;
+				}
+
+				TextureIndices.Add(TextureIndex);
+				ReclaimableBytes += SortedTexture.CurrentSize;
+
+				// Path names are Package.Object(:SubObject), the package is everything before the first '.'.
+				FString PackageName = SortedTexture.Name;
+				int32 DotIndex = INDEX_NONE;
+				if (PackageName.FindChar(TEXT('.'), DotIndex))
+				{
+					PackageName.LeftInline(DotIndex);
+				}
+				int32 PackageBucket = INDEX_NONE;
+				if (const int32* FoundBucket = PackageToBucket.Find(PackageName))
+				{
+					PackageBucket = *FoundBucket;
+				}
+				else
+				{
+					PackageBucket = PackageBuckets.AddDefaulted();
+					PackageToBucket.Add(PackageName, PackageBucket);
+					CopyUtf8(PackageBuckets[PackageBucket].Utf8Label, PackageName);
+				}
+				PackageBuckets[PackageBucket].Bytes += SortedTexture.CurrentSize;
+				++PackageBuckets[PackageBucket].NumTextures;
+
+				const UObject* Keeper = FindKeeper(SortedTexture.Texture.Get());
+				int32 KeeperBucket = INDEX_NONE;
+				if (GraphSnapshotId != 0)
+				{
+					if (const int32* FoundBucket = KeeperToBucket.Find(Keeper))
+					{
+						KeeperBucket = *FoundBucket;
+					}
+					else
+					{
+						KeeperBucket = KeeperBuckets.AddDefaulted();
+						KeeperToBucket.Add(Keeper, KeeperBucket);
+						CopyUtf8(KeeperBuckets[KeeperBucket].Utf8Label, (Keeper != nullptr) ? FString::Printf(TEXT("%s %s"), *Keeper->GetClass()->GetName(), *Keeper->GetPathName()) : FString(TEXT("(no referencer, rooted or standalone)")));
+					}
+					KeeperBuckets[KeeperBucket].Bytes += SortedTexture.CurrentSize;
+					++KeeperBuckets[KeeperBucket].NumTextures;
+				}
+				TextureKeepers.Add(KeeperBucket);
+			}
+
+			bSortDirty = true;
+		}
+
+		// The object most likely keeping the texture loaded. Outer and class edges are skipped, as is anything inside the texture, so
+		//	the texture's own subobjects never count. Referencers that are GC roots come first, then any other non-texture referencer,
+		//	and only then other textures (e.g. a texture referencing it as a composite source).
+		static const UObject* FindKeeper(const UTexture* Texture)
+		{
+			const int32 NodeIndex = ((Texture != nullptr) && ReferenceGraph.IsReady()) ? ReferenceGraph.FindNode(Texture) : INDEX_NONE;
+			if (NodeIndex == INDEX_NONE)
+			{
+				return nullptr;
+			}
+
+			const UObject* ObjectKeeper = nullptr;
+			const UObject* TextureKeeper = nullptr;
+			for (const ImGuiTools::Utils::FObjectReferenceGraph::FReference& Referencer : ReferenceGraph.GetReferencersView(NodeIndex))
+			{
+				if (ReferenceGraph.IsOuterOrClassReference(Referencer))
+				{
+					continue;
+				}
+
+				const UObject* Object = ReferenceGraph.GetNodeObject(Referencer.NodeIndex);
+				if ((Object == nullptr) || (Object == Texture) || Object->IsIn(Texture))
+				{
+					continue;
+				}
+
+				if (Object->IsA<UTexture>())
+				{
+					TextureKeeper = (TextureKeeper != nullptr) ? TextureKeeper : Object;
+				}
+				else if (ReferenceGraph.IsRootNode(Referencer.NodeIndex))
+				{
+					return Object;
+				}
+				else
+				{
+					ObjectKeeper = (ObjectKeeper != nullptr) ? ObjectKeeper : Object;
+				}
+			}
+			return (ObjectKeeper != nullptr) ? ObjectKeeper : TextureKeeper;
+		}
+
+		void SortBy(const FTextureSnapshot& Snapshot)
+		{
+			if (!bSortDirty && (SortedType == SortType))
+			{
+				return;
+			}
+			bSortDirty = false;
+			SortedType = SortType;
+
+			const auto SortBuckets = [this](TArray<FBucket>& Buckets, TArray<int32>& OutOrder)
+			{
+				OutOrder.SetNumUninitialized(Buckets.Num());
+				for (int32 i = 0; i < Buckets.Num(); ++i)
+				{
+					OutOrder[i] = i;
+				}
+				switch (SortType)
+				{
+					default:
+					case ESortType::Bytes:	OutOrder.Sort([&Buckets](int32 LHS, int32 RHS) { return Buckets[LHS].Bytes > Buckets[RHS].Bytes; }); break;
+					case ESortType::Count:	OutOrder.Sort([&Buckets](int32 LHS, int32 RHS) { return Buckets[LHS].NumTextures > Buckets[RHS].NumTextures; }); break;
+					case ESortType::Alpha:	OutOrder.Sort([&Buckets](int32 LHS, int32 RHS) { return FCStringAnsi::Strcmp(Buckets[LHS].GetUtf8Label(), Buckets[RHS].GetUtf8Label()) < 0; }); break;
+				}
+			};
+			SortBuckets(PackageBuckets, PackageOrder);
+			SortBuckets(KeeperBuckets, KeeperOrder);
+
+			TextureOrder.SetNumUninitialized(TextureIndices.Num());
+			for (int32 i = 0; i < TextureIndices.Num(); ++i)
+			{
+				TextureOrder[i] = i;
+			}
+			if (SortType == ESortType::Alpha)
+			{
+				TextureOrder.Sort([this, &Snapshot](int32 LHS, int32 RHS) { return Snapshot.Textures[TextureIndices[LHS]].Name < Snapshot.Textures[TextureIndices[RHS]].Name; });
+			}
+			else
+			{
+				TextureOrder.Sort([this, &Snapshot](int32 LHS, int32 RHS) { return Snapshot.Textures[TextureIndices[LHS]].CurrentSize > Snapshot.Textures[TextureIndices[RHS]].CurrentSize; });
+			}
+		}
+
+		void DrawBuckets(const TArray<FBucket>& Buckets, const TArray<int32>& Order, const char* LabelHeader)
+		{
+			ImGui::Columns(3, "UnreferencedTextureBuckets");
+			ImGui::Text("%s", LabelHeader); ImGui::NextColumn();
+			ImGui::Text("Reclaimable"); ImGui::NextColumn();
+			ImGui::Text("Textures"); ImGui::NextColumn();
+			ImGui::Separator();
+			ImGuiListClipper Clipper;
+			Clipper.Begin(Order.Num());
+			while (Clipper.Step())
+			{
+				for (int RowIndex = Clipper.DisplayStart; RowIndex < Clipper.DisplayEnd; ++RowIndex)
+				{
+					const FBucket& Bucket = Buckets[Order[RowIndex]];
+					ImGui::TextUnformatted(Bucket.GetUtf8Label()); ImGui::NextColumn();
+					ImGui::Text("%.2f MB", (double)Bucket.Bytes / 1024. / 1024.); ImGui::NextColumn();
+					ImGui::Text("%d", Bucket.NumTextures); ImGui::NextColumn();
+				}
+			}
+			ImGui::Columns(1);
+		}
+
+		void Draw(FTextureSnapshot& Snapshot)
+		{
+			Update(Snapshot);
+			SortBy(Snapshot);
+			const int32 SelectedTextureIndex = Snapshot.GetSelectedTextureIndex();
+
+			ImGui::Text("Reclaimable: %.2f MB in %d unreferenced resident textures", (double)ReclaimableBytes / 1024. / 1024., TextureIndices.Num());
+			if (ImGui::IsItemHovered())
+			{
+				ImGui::SetTooltip("Resident 2D textures with a usage count of 0: no primitive component of any world streams them.");
+			}
+
+			if (ImGui::RadioButton("By Package", View == EView::Packages)) { View = EView::Packages; } ImGui::SameLine();
+			if (ImGui::RadioButton("By Keeper", View == EView::Keepers)) { View = EView::Keepers; } ImGui::SameLine();
+			if (ImGui::RadioButton("Textures", View == EView::Textures)) { View = EView::Textures; }
+			ImGui::SameLine();
+			ImGui::Text("  Sort:"); ImGui::SameLine();
+			if (ImGui::RadioButton("Bytes##UnrefSort", SortType == ESortType::Bytes)) { SortType = ESortType::Bytes; } ImGui::SameLine();
+			if (ImGui::RadioButton("Count##UnrefSort", SortType == ESortType::Count)) { SortType = ESortType::Count; } ImGui::SameLine();
+			if (ImGui::RadioButton("Name##UnrefSort", SortType == ESortType::Alpha)) { SortType = ESortType::Alpha; }
+
+			if ((View == EView::Keepers) && !ReferenceGraph.IsReady())
+			{
+				if (ReferenceGraph.GetState() == ImGuiTools::Utils::FObjectReferenceGraph::EState::Empty)
+				{
+					if (ImGui::Button("Build Reference Graph"))
+					{
+						ReferenceGraph.BeginRefresh();
+					}
+					ImGui::SameLine();
+					ImGui::Text("Keepers are found from the object reference graph.");
+				}
+				else
+				{
+					ImGui::ProgressBar(ReferenceGraph.GetProgress(), ImVec2(200.0f, 0.0f), "Collecting references...");
+				}
+				return;
+			}
+
+			ImGui::BeginChild("UnreferencedTextures", ImVec2(0, 250.0f), true);
+			switch (View)
+			{
+				case EView::Packages:	DrawBuckets(PackageBuckets, PackageOrder, "Package"); break;
+				case EView::Keepers:	DrawBuckets(KeeperBuckets, KeeperOrder, "Kept Alive By"); break;
+				case EView::Textures:
+				{
+					ImGui::Columns(3, "UnreferencedTextureList");
+					ImGui::Text("Texture"); ImGui::NextColumn();
+					ImGui::Text("InMem"); ImGui::NextColumn();
+					ImGui::Text("Kept Alive By"); ImGui::NextColumn();
+					ImGui::Separator();
+					ImGuiListClipper Clipper;
+					Clipper.Begin(TextureOrder.Num());
+					while (Clipper.Step())
+					{
+						for (int RowIndex = Clipper.DisplayStart; RowIndex < Clipper.DisplayEnd; ++RowIndex)
+						{
+							const int32 OrphanIndex = TextureOrder[RowIndex];
+							const int32 TextureIndex = TextureIndices[OrphanIndex];
+							ImGui::PushID(TextureIndex);
+							if (ImGui::Selectable(Snapshot.GetDisplayString(TextureIndex, FTextureSnapshot::EDisplayString::Name), SelectedTextureIndex == TextureIndex, ImGuiSelectableFlags_SpanAllColumns))
+							{
+								Snapshot.SelectTexture(TextureIndex);
+							}
+							ImGui::PopID();
+							ImGui::NextColumn();
+							ImGui::TextUnformatted(Snapshot.GetDisplayString(TextureIndex, FTextureSnapshot::EDisplayString::InMem)); ImGui::NextColumn();
+							ImGui::TextUnformatted(KeeperBuckets.IsValidIndex(TextureKeepers[OrphanIndex]) ? KeeperBuckets[TextureKeepers[OrphanIndex]].GetUtf8Label() : "?"); ImGui::NextColumn();
+						}
+					}
+					ImGui::Columns(1);
+					break;
+				}
+			}
+			ImGui::EndChild(); // "UnreferencedTextures"
+		}
+
+		EView View = EView::Packages;
+		ESortType SortType = ESortType::Bytes;
+		ESortType SortedType = ESortType::Bytes;
+		bool bSortDirty = true;
+
+		uint32 SnapshotVersion = 0;
+		uint32 KeeperGraphSnapshotId = 0;
+		uint64 ReclaimableBytes = 0;
+		TArray<int32> TextureIndices;		// into the snapshot's textures
+		TArray<int32> TextureKeepers;		// per entry of TextureIndices, into KeeperBuckets, INDEX_NONE until the graph is built
+		TArray<FBucket> PackageBuckets;
+		TArray<FBucket> KeeperBuckets;
+		TArray<int32> PackageOrder;
+		TArray<int32> KeeperOrder;
+		TArray<int32> TextureOrder;			// into TextureIndices
+	};
+
+	FUnreferencedTextureReport UnreferencedTextureReport;
+
+	// Audit of the snapshot's 2D textures for formats, sizes and streaming settings that waste memory. Each finding carries an estimate
+	//	of the bytes it would save, computed from the pixel format tables for the texture's resident size.
+	struct FTextureAudit
 	{
-		static EResourceSizeMode::Type ResourceSizeMode = EResourceSizeMode::EstimatedTotal;
-		ImGui::Text("%s", Ansi(*InstInspInfo.Class->GetName()));
-		ImGui::SameLine();
-		if (ImGui::SmallButton("Update Instance Memory Data"))
+		enum class EIssue : uint8
 		{
-			InstInspInfo.UpdateObjectMemoryInfo(false, ResourceSizeMode);
+			Uncompressed,	// not block compressed, saving is the size as BC3/BC7 (or BC4 for single channel formats)
+			Oversized,		// resident mips bigger than MaxDimension
+			NPOTNonStreaming,	// non power of two and not streaming, saving is the top mip the streamer could have dropped
+			MissingMips,	// single mip, saving is the top mip minus the mip tail it would need to be able to drop it
+			ForcedResident,	// forced resident streaming texture, saving is the top mip
+			Num
+		};
+
+		static const char* GetIssueName(EIssue Issue)
+		{
+			switch (Issue)
+			{
+				case EIssue::Uncompressed:		return "Uncompressed";
+				case EIssue::Oversized:			return "Oversized";
+				case EIssue::NPOTNonStreaming:	return "NPOT Non Streaming";
+				case EIssue::MissingMips:		return "Missing Mips";
+				case EIssue::ForcedResident:	return "Forced Resident";
+				default:						return "?";
+			}
 		}
-		
-		ImGui::SameLine(0.0f, 50.0f);
 
-		static int ResourceSizeModeComboValue = static_cast<int>(ResourceSizeMode);
-		ImGui::BeginChild("ResourceSizeModeCombo", ImVec2(230.0f, 18.0f));
-		ImGui::Combo("##ResourceSizeModeCombo", &ResourceSizeModeComboValue, "Exclusive\0Estimated Total");
-		ResourceSizeMode = static_cast<EResourceSizeMode::Type>(ResourceSizeModeComboValue);
-		ImGui::EndChild();
+		enum class ESortType : uint8
+		{
+			Savings,
+			Size,
+			Alpha,
+		};
 
-		ImGui::Checkbox("Auto-Update", &InstInspInfo.bAutoRefresh);
-		if (InstInspInfo.bAutoRefresh)
+		struct FAuditRow
 		{
-			ImGui::SameLine(); ImGui::DragFloat("Interval", &InstInspInfo.AutoRefreshTime, 0.01f, 0.01f, 10.0f);
-			ImGui::SameLine(); ImGui::ProgressBar(FMath::Clamp<float>(InstInspInfo.AutoRefreshTimer / InstInspInfo.AutoRefreshTime, 0.0f, 1.0f));
+			int32 TextureIndex = INDEX_NONE;
+			uint8 IssueFlags = 0;	// 1 << EIssue
+			uint64 Savings = 0;		// capped at the texture's resident size, issues overlap
+		};
 
-			InstInspInfo.AutoRefreshTimer -= DeltaTime;
+		static bool IsPowerOfTwo(int32 Value)
+		{
+			return (Value > 0) && ((Value & (Value - 1)) == 0);
+		}
 
-			if (InstInspInfo.AutoRefreshTimer <= 0.0f)
+		static double GetBytesPerPixel(EPixelFormat Format)
+		{
+			const FPixelFormatInfo& FormatInfo = GPixelFormats[Format];
+			const int32 BlockPixels = FormatInfo.BlockSizeX * FormatInfo.BlockSizeY;
+			return (BlockPixels > 0) ? ((double)FormatInfo.BlockBytes / (double)BlockPixels) : 0.0;
+		}
+
+		// Bytes of the resident mips larger than MaxDim.
+		static uint64 GetBytesAboveDimension(const FSortedTexture& SortedTexture, int32 MaxDim)
+		{
+			uint64 Bytes = 0;
+			for (int32 MipIndex = 0; (FMath::Max(SortedTexture.CurSizeX >> MipIndex, SortedTexture.CurSizeY >> MipIndex) > MaxDim); ++MipIndex)
 			{
-				InstInspInfo.AutoRefreshTimer = InstInspInfo.AutoRefreshTime;
-				InstInspInfo.UpdateObjectMemoryInfo(false, ResourceSizeMode);
+				Bytes += CalcTextureMipMapSize(SortedTexture.CurSizeX, SortedTexture.CurSizeY, SortedTexture.Format, MipIndex);
 			}
+			return Bytes;
 		}
-		ImGui::Separator();
-		ImGui::Columns(2);
-		ImGui::SetColumnWidth(0, 330.0f);
-		ImGui::Text("Include/Sort:");
-		ImGui::BeginChild("IncSort", ImVec2(0.0f, 90.0f));
-		ImGui::Columns(2);
-		static const float RadWidth = 54.0f;
-		ImGui::SameLine(27.0f);
-		if (ImGui::RadioButton("##Alpha", InstInspInfo.SortType == MemDebugUtils::EMemSortType::Alpha)) { InstInspInfo.SortBy(MemDebugUtils::EMemSortType::Alpha); } ImGui::SameLine();
-		ImGui::Text("Alpha"); ImGui::NextColumn();
 
-		ImGui::Checkbox("##IsDefaultObject", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::IsDefaultObject)); ImGui::SameLine();
-		ImGui::Text("IsDefaultObject"); 
-		ImGui::Checkbox("##Outer", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::Outer)); ImGui::SameLine();
-		ImGui::Text("Outer"); ImGui::NextColumn();
+		// Estimated savings of each issue found on the texture, 0 if it does not have the issue.
+		void AuditTexture(const FSortedTexture& SortedTexture, uint64 (&OutSavings)[(int32)EIssue::Num]) const
+		{
+			FMemory::Memzero(OutSavings);
+			if ((SortedTexture.CurrentSize <= 0) || (SortedTexture.Format == PF_Unknown))
+			{
+				return;
+			}
 
-		ImGui::Checkbox("##TotalMemCh", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::TotalMem)); ImGui::SameLine();
-		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::TotalMem))
-		{ if (ImGui::RadioButton("##TotalMem", InstInspInfo.SortType == MemDebugUtils::EMemSortType::TotalMem)) { InstInspInfo.SortBy(MemDebugUtils::EMemSortType::TotalMem); } ImGui::SameLine(); }
-		else { ImGui::SameLine(RadWidth); }
-		ImGui::Text("TotalMem"); ImGui::NextColumn();
+			const FPixelFormatInfo& FormatInfo = GPixelFormats[SortedTexture.Format];
+			const uint64 TopMipBytes = CalcTextureMipMapSize(SortedTexture.CurSizeX, SortedTexture.CurSizeY, SortedTexture.Format, 0);
 
-		ImGui::Checkbox("##UnknownMemCh", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::UnknownMem)); ImGui::SameLine();
-		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::UnknownMem))
-		{ if (ImGui::RadioButton("##UnknownMem", InstInspInfo.SortType == MemDebugUtils::EMemSortType::UnknownMem)) { InstInspInfo.SortBy(MemDebugUtils::EMemSortType::UnknownMem); } ImGui::SameLine(); }
-		else { ImGui::SameLine(RadWidth); }
-		ImGui::Text("UnknownMem"); ImGui::NextColumn();
+			if ((FormatInfo.BlockSizeX == 1) && (FormatInfo.BlockSizeY == 1))
+			{
+				const double BytesPerPixel = GetBytesPerPixel(SortedTexture.Format);
+				const double CompressedBytesPerPixel = GetBytesPerPixel((FormatInfo.NumComponents == 1) ? PF_BC4 : PF_DXT5);
+				if (BytesPerPixel > CompressedBytesPerPixel)
+				{
+					OutSavings[(int32)EIssue::Uncompressed] = (uint64)(SortedTexture.CurrentSize * (1.0 - (CompressedBytesPerPixel / BytesPerPixel)));
+				}
+			}
 
-		ImGui::Checkbox("##DedSysMemCh", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedSysMem)); ImGui::SameLine();
-		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedSysMem))
-		{ if (ImGui::RadioButton("##DedSysMem", InstInspInfo.SortType == MemDebugUtils::EMemSortType::DedSysMem)) { InstInspInfo.SortBy(MemDebugUtils::EMemSortType::DedSysMem); } ImGui::SameLine(); }
-		else { ImGui::SameLine(RadWidth); }
-		ImGui::Text("DedSysMem"); ImGui::NextColumn();
+			OutSavings[(int32)EIssue::Oversized] = GetBytesAboveDimension(SortedTexture, MaxDimension);
 
-		ImGui::Checkbox("##DedVidMemCh", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedVidMem)); ImGui::SameLine();
-		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedVidMem))
-		{ if (ImGui::RadioButton("##DedVidMem", InstInspInfo.SortType == MemDebugUtils::EMemSortType::DedVidMem)) { InstInspInfo.SortBy(MemDebugUtils::EMemSortType::DedVidMem); } ImGui::SameLine(); }
-		else { ImGui::SameLine(RadWidth); }
-		ImGui::Text("DedVidMem"); ImGui::NextColumn();
+			if (!SortedTexture.bIsStreaming && (!IsPowerOfTwo(SortedTexture.SizeX) || !IsPowerOfTwo(SortedTexture.SizeY)))
+			{
+				OutSavings[(int32)EIssue::NPOTNonStreaming] = TopMipBytes;
+			}
 
-		ImGui::Checkbox("##SharedSysMemCh", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedSysMem)); ImGui::SameLine();
-		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedSysMem))
-		{ if (ImGui::RadioButton("##SharedSysMem", InstInspInfo.SortType == MemDebugUtils::EMemSortType::SharedSysMem)) { InstInspInfo.SortBy(MemDebugUtils::EMemSortType::SharedSysMem); } ImGui::SameLine(); }
-		else { ImGui::SameLine(RadWidth); }
-		ImGui::Text("SharedSysMem"); ImGui::NextColumn();
+			// UI textures are expected to have a single mip.
+			if ((SortedTexture.NumMips == 1) && (SortedTexture.LODGroup != TEXTUREGROUP_UI) && (FMath::Max(SortedTexture.SizeX, SortedTexture.SizeY) > 1))
+			{
+				const int32 FullMipCount = FMath::FloorLog2(FMath::Max(SortedTexture.CurSizeX, SortedTexture.CurSizeY)) + 1;
+				const uint64 MipTailBytes = CalcTextureSize(FMath::Max(SortedTexture.CurSizeX >> 1, 1), FMath::Max(SortedTexture.CurSizeY >> 1, 1), SortedTexture.Format, FMath::Max(FullMipCount - 1, 1));
+				OutSavings[(int32)EIssue::MissingMips] = (TopMipBytes > MipTailBytes) ? (TopMipBytes - MipTailBytes) : 0;
+			}
 
-		ImGui::Checkbox("##SharedVidMemCh", &InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedVidMem)); ImGui::SameLine();
-		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedVidMem))
-		{ if (ImGui::RadioButton("##SharedVidMem", InstInspInfo.SortType == MemDebugUtils::EMemSortType::SharedVidMem)) { InstInspInfo.SortBy(MemDebugUtils::EMemSortType::SharedVidMem); } ImGui::SameLine(); }
-		else { ImGui::SameLine(RadWidth); }
-		ImGui::Text("SharedVidMem"); ImGui::NextColumn();
+			if (SortedTexture.bIsForced)
+			{
+				OutSavings[(int32)EIssue::ForcedResident] = TopMipBytes;
+			}
+		}
 
-		ImGui::Columns(1);
-		ImGui::EndChild(); // "IncSort"
-		ImGui::SetColumnWidth(1, 330.0f);
+		// Rebuild when the snapshot or the audit settings changed.
+		void Update(const FTextureSnapshot& Snapshot)
+		{
+			if ((SnapshotVersion == Snapshot.SnapshotVersion) && (AuditedMaxDimension == MaxDimension))
+			{
+				return;
+			}
+			SnapshotVersion = Snapshot.SnapshotVersion;
+			AuditedMaxDimension = MaxDimension;
+
+			Rows.Reset();
+			FMemory::Memzero(IssueCounts);
+			FMemory::Memzero(IssueSavings);
+			TotalSavings = 0;
+			for (int32 TextureIndex = 0; TextureIndex < Snapshot.Textures.Num(); ++TextureIndex)
+			{
+				const FSortedTexture& SortedTexture = Snapshot.Textures[TextureIndex];
+				if (!SortedTexture.bUsageTracked)
+				{
+					continue;
+				}
 
+				uint64 Savings[(int32)EIssue::Num];
+				AuditTexture(SortedTexture, Savings);
 
-		ImGui::NextColumn();
-		InstInspInfo.NameFilter.Draw("Name Filter", ImGui::GetColumnWidth() - 100.0f);
-		ImGui::Columns(1);
-		ImGui::BeginChild("InstLabel", ImVec2(0, 50.0f), true);
+				FAuditRow Row;
+				Row.TextureIndex = TextureIndex;
+				for (int32 Issue = 0; Issue < (int32)EIssue::Num; ++Issue)
+				{
+					if (Savings[Issue] > 0)
+					{
+						Row.IssueFlags |= (1 << Issue);
+						Row.Savings += Savings[Issue];
+						++IssueCounts[Issue];
+						IssueSavings[Issue] += Savings[Issue];
+					}
+				}
+				if (Row.IssueFlags != 0)
+				{
+					Row.Savings = FMath::Min<uint64>(Row.Savings, SortedTexture.CurrentSize);
+					TotalSavings += Row.Savings;
+					Rows.Add(Row);
+				}
+			}
 
-		ImGui::Text("Total Instances: %d    Total Size: % .04fMB", InstInspInfo.Instances, InstInspInfo.MemInfo.TotalMemoryMB);
-		ImGui::Separator();
+			bVisibleRowsDirty = true;
+		}
 
-		static constexpr int ColumnCount = 9;
-		InstInspInfo.ShowCols.GetShowCol(EColumnTypes::Instances) = false; // gross: Instances is disabled for this view so ensure it is off so CacheColCount() is contextually correct
-		const int VisibleColCount = InstInspInfo.ShowCols.CacheShowColCount() + 1;
-		ImGui::Columns(VisibleColCount, "ObjInstCol");
-		static float ColumnWidths[ColumnCount];
-		static constexpr float InfoColWidth = 110.0f;
-		ColumnWidths[0] = ImGui::GetWindowWidth() - (InfoColWidth * (VisibleColCount - 1)); // Object col
-		if (VisibleColCount > 1)
+		void UpdateVisibleRows(const FTextureSnapshot& Snapshot)
 		{
-			for (int i = 0; i < VisibleColCount; ++i)
+			if (!bVisibleRowsDirty && (VisibleSortType == SortType) && (VisibleIssueMask == IssueMask))
 			{
-				if (i > 0)
+				return;
+			}
+			bVisibleRowsDirty = false;
+			VisibleSortType = SortType;
+			VisibleIssueMask = IssueMask;
+
+			VisibleRows.Reset();
+			VisibleSavings = 0;
+			for (int32 RowIndex = 0; RowIndex < Rows.Num(); ++RowIndex)
+			{
+				if ((Rows[RowIndex].IssueFlags & IssueMask) != 0)
 				{
-					ColumnWidths[i] = InfoColWidth;
+					VisibleRows.Add(RowIndex);
+					VisibleSavings += Rows[RowIndex].Savings;
 				}
-				ImGui::SetColumnWidth(i, ColumnWidths[i]);
+			}
+
+			switch (SortType)
+			{
+				default:
+				case ESortType::Savings:	VisibleRows.Sort([this](int32 LHS, int32 RHS) { return Rows[LHS].Savings > Rows[RHS].Savings; }); break;
+				case ESortType::Size:		VisibleRows.Sort([this, &Snapshot](int32 LHS, int32 RHS) { return Snapshot.Textures[Rows[LHS].TextureIndex].CurrentSize > Snapshot.Textures[Rows[RHS].TextureIndex].CurrentSize; }); break;
+				case ESortType::Alpha:		VisibleRows.Sort([this, &Snapshot](int32 LHS, int32 RHS) { return Snapshot.Textures[Rows[LHS].TextureIndex].Name < Snapshot.Textures[Rows[RHS].TextureIndex].Name; }); break;
 			}
 		}
-		ImGui::Text("Object"); ImGui::NextColumn();
-		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::IsDefaultObject)) { ImGui::Text("Is Default Obj"); ImGui::NextColumn(); }
-		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::Outer)) { ImGui::Text("Outer"); ImGui::NextColumn(); }
-		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::TotalMem)) { ImGui::Text("Total Mem"); ImGui::NextColumn(); }
-		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::UnknownMem)) { ImGui::Text("Unknown Mem"); ImGui::NextColumn(); }
-		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedSysMem)) { ImGui::Text("DedSys Mem"); ImGui::NextColumn(); }
-		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedVidMem)) { ImGui::Text("DedVid Mem"); ImGui::NextColumn(); }
-		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedSysMem)) { ImGui::Text("SharedSys Mem"); ImGui::NextColumn(); }
-		if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedVidMem)) { ImGui::Text("SharedVid Mem"); ImGui::NextColumn(); }
+
+		void Draw(FTextureSnapshot& Snapshot)
+		{
+			ImGui::SetNextItemWidth(80.0f);
+			ImGui::DragInt("Max Dimension", &MaxDimension, 16.0f, 64, 16384);
+			if (ImGui::IsItemHovered())
+			{
+				ImGui::SetTooltip("Resident mips larger than this are flagged as oversized.");
+			}
+
+			Update(Snapshot);
+
+			// Issue summary doubles as the issue filter.
+			ImGui::Columns(3, "TextureAuditIssues");
+			ImGui::Text("Issue"); ImGui::NextColumn();
+			ImGui::Text("Textures"); ImGui::NextColumn();
+			ImGui::Text("Est. Savings"); ImGui::NextColumn();
+			ImGui::Separator();
+			for (int32 Issue = 0; Issue < (int32)EIssue::Num; ++Issue)
+			{
+				bool bShowIssue = (IssueMask & (1 << Issue)) != 0;
+				if (ImGui::Checkbox(GetIssueName((EIssue)Issue), &bShowIssue))
+				{
+					IssueMask ^= (1 << Issue);
+				}
+				ImGui::NextColumn();
+				ImGui::Text("%d", IssueCounts[Issue]); ImGui::NextColumn();
+				ImGui::Text("%.2f MB", (double)IssueSavings[Issue] / 1024. / 1024.); ImGui::NextColumn();
+			}
+			ImGui::Columns(1);
+
+			UpdateVisibleRows(Snapshot);
+			ImGui::Text("Potential savings: %.2f MB shown, %.2f MB total (overlapping issues are counted once per texture)", (double)VisibleSavings / 1024. / 1024., (double)TotalSavings / 1024. / 1024.);
+
+			ImGui::Text("Sort:"); ImGui::SameLine();
+			if (ImGui::RadioButton("Savings##AuditSort", SortType == ESortType::Savings)) { SortType = ESortType::Savings; } ImGui::SameLine();
+			if (ImGui::RadioButton("Size##AuditSort", SortType == ESortType::Size)) { SortType = ESortType::Size; } ImGui::SameLine();
+			if (ImGui::RadioButton("Name##AuditSort", SortType == ESortType::Alpha)) { SortType = ESortType::Alpha; }
+
+			const int32 SelectedTextureIndex = Snapshot.GetSelectedTextureIndex();
+			ImGui::BeginChild("TextureAudit", ImVec2(0, 250.0f), true);
+			ImGui::Columns(5, "TextureAuditList");
+			ImGui::Text("Texture"); ImGui::NextColumn();
+			ImGui::Text("InMem"); ImGui::NextColumn();
+			ImGui::Text("Format"); ImGui::NextColumn();
+			ImGui::Text("Est. Savings"); ImGui::NextColumn();
+			ImGui::Text("Issues"); ImGui::NextColumn();
+			ImGui::Separator();
+			ImGuiListClipper Clipper;
+			Clipper.Begin(VisibleRows.Num());
+			while (Clipper.Step())
+			{
+				for (int VisibleIndex = Clipper.DisplayStart; VisibleIndex < Clipper.DisplayEnd; ++VisibleIndex)
+				{
+					using EDisplayString = FTextureSnapshot::EDisplayString;
+					const FAuditRow& Row = Rows[VisibleRows[VisibleIndex]];
+					ImGui::PushID(Row.TextureIndex);
+					if (ImGui::Selectable(Snapshot.GetDisplayString(Row.TextureIndex, EDisplayString::Name), SelectedTextureIndex == Row.TextureIndex, ImGuiSelectableFlags_SpanAllColumns))
+					{
+						Snapshot.SelectTexture(Row.TextureIndex);
+					}
+					ImGui::PopID();
+					ImGui::NextColumn();
+					ImGui::TextUnformatted(Snapshot.GetDisplayString(Row.TextureIndex, EDisplayString::InMem)); ImGui::NextColumn();
+					ImGui::TextUnformatted(Snapshot.GetDisplayString(Row.TextureIndex, EDisplayString::Format)); ImGui::NextColumn();
+					ImGui::Text("%i KB", (int32)((Row.Savings + 512) / 1024)); ImGui::NextColumn();
+					for (int32 Issue = 0, NumDrawn = 0; Issue < (int32)EIssue::Num; ++Issue)
+					{
+						if ((Row.IssueFlags & (1 << Issue)) != 0)
+						{
+							if (NumDrawn++ > 0)
+							{
+								ImGui::SameLine();
+							}
+							ImGui::TextUnformatted(GetIssueName((EIssue)Issue));
+						}
+					}
+					ImGui::NextColumn();
+				}
+			}
+			ImGui::Columns(1);
+			ImGui::EndChild(); // "TextureAudit"
+		}
+
+		int32 MaxDimension = 4096;
+		int32 AuditedMaxDimension = 0;
+		ESortType SortType = ESortType::Savings;
+		uint8 IssueMask = (1 << (int32)EIssue::Num) - 1;
+
+		uint32 SnapshotVersion = 0;
+		TArray<FAuditRow> Rows;
+		int32 IssueCounts[(int32)EIssue::Num] = {};
+		uint64 IssueSavings[(int32)EIssue::Num] = {};
+		uint64 TotalSavings = 0;
+
+		bool bVisibleRowsDirty = true;
+		ESortType VisibleSortType = ESortType::Savings;
+		uint8 VisibleIssueMask = 0;
+		TArray<int32> VisibleRows;	// into Rows
+		uint64 VisibleSavings = 0;
+	};
+
+	FTextureAudit TextureAudit;
+
+	// Resident vs max allowed memory per LOD group and pixel format. Groups over their budget from the developer settings are drawn
+	//	red, with a history of the group's resident memory over the last snapshots so a spike during a traversal can be traced back.
+	void DrawTextureBudgets(const FTextureSnapshot& Snapshot)
+	{
+		const int32 NumGroups = Snapshot.TextureGroupNames.Num();
+		if (!Snapshot.HasSnapshot() || (Snapshot.TextureGroupCurrentSizes.Num() != NumGroups))
+		{
+			ImGui::Text("No texture snapshot yet.");
+			return;
+		}
+
+		TArray<float> GroupBudgetsMB;
+		GroupBudgetsMB.Init(0.0f, NumGroups);
+		for (const FImGuiToolsTextureGroupBudget& Budget : GetDefault<UImGuiToolsDeveloperSettings>()->MemoryDebuggerTextureGroupBudgets)
+		{
+			if (GroupBudgetsMB.IsValidIndex(Budget.LODGroup))
+			{
+				GroupBudgetsMB[Budget.LODGroup] = Budget.BudgetMB;
+			}
+		}
+
+		TArray<int32> Groups;
+		for (int32 GroupIndex = 0; GroupIndex < NumGroups; ++GroupIndex)
+		{
+			if ((Snapshot.TextureGroupMaxAllowedSizes[GroupIndex] > 0) || (GroupBudgetsMB[GroupIndex] > 0.0f))
+			{
+				Groups.Add(GroupIndex);
+			}
+		}
+		Groups.Sort([&Snapshot](int32 LHS, int32 RHS) { return Snapshot.TextureGroupCurrentSizes[LHS] > Snapshot.TextureGroupCurrentSizes[RHS]; });
+
+		const auto ToMB = [](uint64 Bytes) { return (double)Bytes / 1024. / 1024.; };
+		const ImVec4 OverBudgetColor(1.0f, 0.3f, 0.3f, 1.0f);
+
+		ImGui::Columns(6, "TextureGroupBudgets");
+		ImGui::Text("LOD Group"); ImGui::NextColumn();
+		ImGui::Text("InMem"); ImGui::NextColumn();
+		ImGui::Text("OnDisk"); ImGui::NextColumn();
+		ImGui::Text("Budget"); ImGui::NextColumn();
+		ImGui::Text("Budget Used"); ImGui::NextColumn();
+		ImGui::Text("History (%d snapshots)", Snapshot.GetNumHistorySamples()); ImGui::NextColumn();
+		ImGui::Separator();
+		for (int32 GroupIndex : Groups)
+		{
+			const double CurrentMB = ToMB(Snapshot.TextureGroupCurrentSizes[GroupIndex]);
+			const float BudgetMB = GroupBudgetsMB[GroupIndex];
+			const bool bOverBudget = (BudgetMB > 0.0f) && (CurrentMB > BudgetMB);
+
+			// Peak of the history, to tell groups that went over budget earlier in the traversal.
+			int32 PeakAge = 0;
+			for (int32 Age = 1; Age < Snapshot.GetNumHistorySamples(); ++Age)
+			{
+				if (Snapshot.GetGroupHistoryMB(GroupIndex, Age) > Snapshot.GetGroupHistoryMB(GroupIndex, PeakAge))
+				{
+					PeakAge = Age;
+				}
+			}
+			const float PeakMB = (Snapshot.GetNumHistorySamples() > 0) ? Snapshot.GetGroupHistoryMB(GroupIndex, PeakAge) : 0.0f;
+			const bool bPeakOverBudget = (BudgetMB > 0.0f) && (PeakMB > BudgetMB);
+
+			if (bOverBudget)
+			{
+				ImGui::PushStyleColor(ImGuiCol_Text, OverBudgetColor);
+			}
+			ImGui::Text("%s", Ansi(*Snapshot.TextureGroupNames[GroupIndex])); ImGui::NextColumn();
+			ImGui::Text("%.2f MB", CurrentMB); ImGui::NextColumn();
+			ImGui::Text("%.2f MB", ToMB(Snapshot.TextureGroupMaxAllowedSizes[GroupIndex])); ImGui::NextColumn();
+			if (BudgetMB > 0.0f)
+			{
+				ImGui::Text("%.2f MB", BudgetMB); ImGui::NextColumn();
+				ImGui::ProgressBar((float)(CurrentMB / BudgetMB), ImVec2(-1.0f, 0.0f), Ansi(*FString::Printf(TEXT("%.0f%%"), (CurrentMB / BudgetMB) * 100.0))); ImGui::NextColumn();
+			}
+			else
+			{
+				ImGui::Text("-"); ImGui::NextColumn();
+				ImGui::NextColumn();
+			}
+			if (bOverBudget)
+			{
+				ImGui::PopStyleColor();
+			}
+
+			if (Snapshot.GetNumHistorySamples() > 0)
+			{
+				const TRingHistory<float, FTextureSnapshot::NumHistorySamples>& GroupHistory = Snapshot.GroupHistoryMB[GroupIndex];
+				if (bPeakOverBudget)
+				{
+					ImGui::PushStyleColor(ImGuiCol_PlotLines, OverBudgetColor);
+				}
+				ImGui::PushID(GroupIndex);
+				ImGui::PlotLines("##GroupHistory", GroupHistory.GetData(), GroupHistory.Num(), GroupHistory.GetOldestOffset(),
+								 nullptr, 0.0f, FMath::Max(PeakMB, BudgetMB), ImVec2(-1.0f, ImGui::GetTextLineHeight()));
+				ImGui::PopID();
+				if (bPeakOverBudget)
+				{
+					ImGui::PopStyleColor();
+				}
+				if (ImGui::IsItemHovered())
+				{
+					ImGui::SetTooltip("Peak: %.2f MB, %.0f s ago%s", PeakMB, FPlatformTime::Seconds() - Snapshot.GetHistoryTime(PeakAge), bPeakOverBudget ? "\nWent over budget" : "");
+				}
+			}
+			ImGui::NextColumn();
+		}
 		ImGui::Columns(1);
-		ImGui::EndChild();	  // "InstLabel"
+		ImGui::Separator();
+
+		TArray<int32> Formats;
+		for (int32 FormatIndex = 0; FormatIndex < PF_MAX; ++FormatIndex)
+		{
+			if (Snapshot.FormatMaxAllowedSizes[FormatIndex] > 0)
+			{
+				Formats.Add(FormatIndex);
+			}
+		}
+		Formats.Sort([&Snapshot](int32 LHS, int32 RHS) { return Snapshot.FormatCurrentSizes[LHS] > Snapshot.FormatCurrentSizes[RHS]; });
+
+		ImGui::Columns(3, "TextureFormatBudgets");
+		ImGui::Text("Format"); ImGui::NextColumn();
+		ImGui::Text("InMem"); ImGui::NextColumn();
+		ImGui::Text("OnDisk"); ImGui::NextColumn();
+		ImGui::Separator();
+		for (int32 FormatIndex : Formats)
+		{
+			ImGui::Text("%s", Ansi(GetPixelFormatString((EPixelFormat)FormatIndex))); ImGui::NextColumn();
+			ImGui::Text("%.2f MB", ToMB(Snapshot.FormatCurrentSizes[FormatIndex])); ImGui::NextColumn();
+			ImGui::Text("%.2f MB", ToMB(Snapshot.FormatMaxAllowedSizes[FormatIndex])); ImGui::NextColumn();
+		}
+		ImGui::Columns(1);
+	}
+
+	///////////////////////////////////////
+	/////////  Texture Streaming Telemetry
+	//	Samples the render asset streaming manager and the streaming state of every streaming texture into preallocated ring buffers,
+	//	so pool pressure and streaming thrash (e.g. around camera cuts) can be seen over the last few minutes. The texture walk is
+	//	time-sliced across frames and its totals land in the sample pushed when the pass completes.
+
+	struct FTextureStreamingTelemetry
+	{
+		static constexpr int32 NumSamples = 1024;	// ring buffer length per series
+
+		enum class ESeries : uint8
+		{
+			PoolSizeMB,
+			RequiredMB,
+			ResidentMB,
+			OverBudgetMB,
+			PendingMips,		// textures with more mips requested than resident
+			DroppingMips,		// textures with fewer mips requested than resident
+			WantingResources,
+			Num
+		};
+
+		void Reset()
+		{
+			for (TRingHistory<float, NumSamples>& SeriesSamples : Samples)
+			{
+				SeriesSamples.Reset();
+			}
+			bPassRunning = false;
+			PassTextures.Reset();
+		}
+
+		// Every series gets a sample on every completed pass, so they all hold the same number of samples.
+		int32 GetNumSamples() const
+		{
+			return Samples[0].Num();
+		}
 
-		if (ImGui::CollapsingHeader("All Instances", ImGuiTreeNodeFlags_DefaultOpen))
+		// Called every frame from the tool update. Starts a texture pass every SampleEveryNFrames and progresses it by up to
+		//	PassBudgetMs, pushing a sample once every texture has been visited.
+		void Tick()
 		{
-			ImGui::BeginChild("InstInfo", ImVec2(0, 360.0f), true);
-			ImGui::Columns(VisibleColCount, "ObjInstCol");
-			if (VisibleColCount > 1)
+			if (!bEnabled)
+			{
+				return;
+			}
+
+			if (!bPassRunning)
 			{
-				for (int i = 0; i < VisibleColCount; ++i)
+				if ((GFrameCounter - LastSampleFrame) < (uint64)SampleEveryNFrames)
 				{
-					ImGui::SetColumnWidth(i, ColumnWidths[i]);
+					return;
 				}
+				LastSampleFrame = GFrameCounter;
+				BeginPass();
 			}
-			for (const FInstanceInspectorInstanceInfo& InspInstance : InstInspInfo.InstanceInfos)
+
+			const double SliceEndTime = FPlatformTime::Seconds() + (PassBudgetMs / 1000.0);
+			while (PassCursor < PassTextures.Num())
 			{
-				if (!InstInspInfo.NameFilter.IsActive() || InstInspInfo.NameFilter.PassFilter(TCHAR_TO_ANSI(*GetNameSafe(InspInstance.InstanceWkPtr.Get()))))
+				UTexture2D* Texture = PassTextures[PassCursor++].Get();
+				if ((Texture != nullptr) && (Texture->GetStreamingIndex() != INDEX_NONE))
 				{
-					if (InspInstance.InstanceWkPtr.IsValid() && !InspInstance.InstanceWkPtr.IsStale())
-					{
-						if (ImGui::SmallButton(Ansi(*FString::Printf(TEXT("Inspect##%.54ls"), *GetNameSafe(InspInstance.InstanceWkPtr.Get())))))
-						{
-							InstInspInfo.InspectedInstance.SetInpectedInstance(InspInstance.InstanceWkPtr);
-						}
-						ImGui::SameLine();
-						ImGui::Text("%s", Ansi(*InspInstance.InstanceWkPtr->GetName()));
-						if (ImGui::IsItemHovered())
-						{
-							DrawHoveredItemInstanceTooltip(InspInstance.InstanceWkPtr.Get());
-						}
-						ImGui::NextColumn();
+					const int32 ResidentMips = Texture->GetNumResidentMips();
+					const int32 RequestedMips = Texture->GetNumRequestedMips();
+					const uint64 ResidentBytes = Texture->CalcTextureMemorySize(ResidentMips);
+					PassResidentBytes += ResidentBytes;
+					PassRequiredBytes += (RequestedMips == ResidentMips) ? ResidentBytes : Texture->CalcTextureMemorySize(RequestedMips);
+					PassPending += (RequestedMips > ResidentMips) ? 1 : 0;
+					PassDropping += (RequestedMips < ResidentMips) ? 1 : 0;
+				}
 
-						if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::IsDefaultObject)) { ImGui::Text(InspInstance.InstanceWkPtr->IsDefaultSubobject() ? "true" : "false"); ImGui::NextColumn(); }
-						if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::Outer)) { 
-							ImGui::Text("%s", Ansi(*GetNameSafe(InspInstance.InstanceWkPtr->GetOuter()))); 
-							if (ImGui::IsItemHovered())
-							{
-								DrawHoveredItemInstanceTooltip(InspInstance.InstanceWkPtr.Get());
-							}
-						
-							ImGui::NextColumn(); 
-						}
-					}
-					else
-					{
-						ImGui::Text("STALE/INVALID PTR"); ImGui::NextColumn();
-						if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::IsDefaultObject)) { ImGui::NextColumn(); }
-						if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::Outer)) { ImGui::NextColumn(); }
-					}
-				
-					if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::TotalMem)) { ImGui::Text("%.04f MB", InspInstance.MemInfo.TotalMemoryMB); ImGui::NextColumn(); }
-					if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::UnknownMem)) { ImGui::Text("%.04f MB", InspInstance.MemInfo.UnknownMemoryMB); ImGui::NextColumn(); }
-					if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedSysMem)) { ImGui::Text("%.04f MB", InspInstance.MemInfo.DedSysMemoryMB); ImGui::NextColumn(); }
-					if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::DedVidMem)) { ImGui::Text("%.04f MB", InspInstance.MemInfo.DedVidMemoryMB); ImGui::NextColumn(); }
-					if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedSysMem)) { ImGui::Text("%.04f MB", InspInstance.MemInfo.SharedSysMemoryMB); ImGui::NextColumn(); }
-					if (InstInspInfo.ShowCols.GetShowCol(EColumnTypes::SharedVidMem)) { ImGui::Text("%.04f MB", InspInstance.MemInfo.SharedVidMemoryMB); ImGui::NextColumn(); }
+				if (((PassCursor & 0x1F) == 0) && (FPlatformTime::Seconds() > SliceEndTime))
+				{
+					return;
 				}
 			}
-			ImGui::Columns(1);
-			ImGui::EndChild(); // "InstInfo"
+
+			FinishPass();
 		}
 
-		if (ImGui::CollapsingHeader("Inspected Instance", ImGuiTreeNodeFlags_DefaultOpen))
+		void BeginPass()
 		{
-			ImGui::BeginChild("InspectedInstance", ImVec2(0, 440.0f), true);
+			PassCursor = 0;
+			PassRequiredBytes = 0;
+			PassResidentBytes = 0;
+			PassPending = 0;
+			PassDropping = 0;
+
+			TArray<UObject*> TextureObjects;
+			GetObjectsOfClass(UTexture2D::StaticClass(), TextureObjects, true, RF_ClassDefaultObject);
+			PassTextures.Reset(TextureObjects.Num());
+			for (UObject* TextureObject : TextureObjects)
+			{
+				PassTextures.Add(static_cast<UTexture2D*>(TextureObject));
+			}
+			bPassRunning = true;
+		}
 
-			UObject* InspectedInstanceRawPtr = InstInspInfo.InspectedInstance.InspectedWkPtr.Get();
-			if (IsValid(InspectedInstanceRawPtr))
+		// Push the texture totals of the completed pass along with the streaming manager's current figures.
+		void FinishPass()
+		{
+			bPassRunning = false;
+			PassTextures.Reset();
+
+			float Values[(int32)ESeries::Num] = {};
+			const auto SetSample = [&Values](ESeries Series, float Value) { Values[(int32)Series] = Value; };
+			if (!IStreamingManager::HasShutdown())
 			{
-				ImGui::Text("        Object: %s (%p)", Ansi(*GetNameSafe(InspectedInstanceRawPtr)), InspectedInstanceRawPtr);
-				ImGui::Text("         Class: %s", Ansi(*GetNameSafe(InspectedInstanceRawPtr->GetClass())));
-				ImGui::Text("         World: %s (%p)", Ansi(*GetNameSafe(InspectedInstanceRawPtr->GetWorld())), InspectedInstanceRawPtr->GetWorld());
-				ImGui::Text("         Outer: %s", Ansi(*GetNameSafe(InspectedInstanceRawPtr->GetOuter())));
-				ImGui::Text("default SubObj: %d", InspectedInstanceRawPtr->IsDefaultSubobject());
+				IRenderAssetStreamingManager& StreamingManager = IStreamingManager::Get().GetRenderAssetStreamingManager();
+				SetSample(ESeries::PoolSizeMB, (float)((double)StreamingManager.GetPoolSize() / 1024. / 1024.));
+				SetSample(ESeries::OverBudgetMB, (float)((double)StreamingManager.GetMemoryOverBudget() / 1024. / 1024.));
+				SetSample(ESeries::WantingResources, (float)IStreamingManager::Get().GetNumWantingResources());
+			}
+			SetSample(ESeries::RequiredMB, (float)((double)PassRequiredBytes / 1024. / 1024.));
+			SetSample(ESeries::ResidentMB, (float)((double)PassResidentBytes / 1024. / 1024.));
+			SetSample(ESeries::PendingMips, (float)PassPending);
+			SetSample(ESeries::DroppingMips, (float)PassDropping);
 
-				if (ImGui::Button("Refresh Referencers (SLOW!)"))
-				{
-					InstInspInfo.InspectedInstance.UpdateInspectedInstanceReferencers();
-				}
+			for (int32 SeriesIndex = 0; SeriesIndex < (int32)ESeries::Num; ++SeriesIndex)
+			{
+				Samples[SeriesIndex].Push(Values[SeriesIndex]);
+			}
+		}
 
-				const auto DrawReferencers = [](const TArray<FReferencerInfo>& CachedReferencerInfo, const FString& HeaderString)
-				{
-					static constexpr int RefInfoColumnCount = 4;
-					ImGui::Columns(RefInfoColumnCount);
-					ImGui::Text("Name"); ImGui::NextColumn();
-					ImGui::Text("Class"); ImGui::NextColumn();
-					ImGui::Text("World"); ImGui::NextColumn();
-					ImGui::Text("Properties"); ImGui::NextColumn();
-					ImGui::Columns(1);
+		// Sample Age steps back from the newest one (Age 0).
+		float GetSample(ESeries Series, int32 Age) const
+		{
+			return Samples[(int32)Series].Get(Age);
+		}
 
-					ImGui::BeginChild(Ansi(*HeaderString), ImVec2(0, 200.0f), true);
-					ImGui::Columns(RefInfoColumnCount);
+		float GetMaxSample(ESeries Series) const
+		{
+			float MaxValue = 0.0f;
+			for (int32 Age = 0; Age < GetNumSamples(); ++Age)
+			{
+				MaxValue = FMath::Max(MaxValue, GetSample(Series, Age));
+			}
+			return MaxValue;
+		}
 
-					int RefIter = 0;
-					for (const FReferencerInfo& ReferencerInfo : CachedReferencerInfo)
-					{
-						UObject* ReferencerRawPtr = ReferencerInfo.ReferencerWkPtr.Get();
-						ImGui::Text("%03d: %s(%p) (refs: %d)", ++RefIter, Ansi(*GetNameSafe(ReferencerRawPtr)), ReferencerRawPtr, ReferencerInfo.TotalReferences); ImGui::NextColumn();
+		void DrawSeries(ESeries Series, const char* Label, const char* Format, float ScaleMax, float Height) const
+		{
+			const TRingHistory<float, NumSamples>& SeriesSamples = Samples[(int32)Series];
+			if (SeriesSamples.Num() == 0)
+			{
+				return;
+			}
 
-						if (IsValid(ReferencerRawPtr))
-						{
-							ImGui::Text("%s", Ansi(*GetNameSafe(ReferencerRawPtr->GetClass()))); ImGui::NextColumn();
-							ImGui::Text("%s", Ansi(*GetNameSafe(ReferencerRawPtr->GetWorld()))); ImGui::NextColumn();
-							for (int i = 0; i < ReferencerInfo.ReferencingProperties.Num(); ++i)
-							{
-								const FString& RefPropName = ReferencerInfo.ReferencingProperties[i];
-								ImGui::Text("%02d: %s", (i+1), Ansi(*RefPropName));
-							}
-							ImGui::NextColumn();
-						}
-						else
-						{
-							ImGui::Text("*invalid*"); ImGui::NextColumn();
-							ImGui::Text("*invalid*"); ImGui::NextColumn();
-							ImGui::Text("*invalid*"); ImGui::NextColumn();
-						}
-					}
+			char Overlay[64];
+			FCStringAnsi::Snprintf(Overlay, sizeof(Overlay), Format, GetSample(Series, 0), GetMaxSample(Series));
+			ImGui::PlotLines(Label, SeriesSamples.GetData(), SeriesSamples.Num(), SeriesSamples.GetOldestOffset(), Overlay, 0.0f, ScaleMax, ImVec2(-150.0f, Height));
+		}
 
-					ImGui::Columns(1);
-					ImGui::EndChild();
-				};
+		bool bEnabled = false;
+		int32 SampleEveryNFrames = 10;	// minimum frames between the starts of two texture passes
+		float PassBudgetMs = 0.5f;
+		uint64 LastSampleFrame = 0;
+		TRingHistory<float, NumSamples> Samples[(int32)ESeries::Num];
+
+		// Texture pass in progress
+		bool bPassRunning = false;
+		int32 PassCursor = 0;
+		TArray<TWeakObjectPtr<UTexture2D>> PassTextures;
+		uint64 PassRequiredBytes = 0;
+		uint64 PassResidentBytes = 0;
+		int32 PassPending = 0;
+		int32 PassDropping = 0;
+	};
 
+	FTextureStreamingTelemetry TextureStreamingTelemetry;
 
-				const FString& InternalRefHeader = FString::Printf(TEXT("Internal Referencers count: %d"), InstInspInfo.InspectedInstance.CachedInternalReferencers.Num());
-				const FString& ExternalRefHeader = FString::Printf(TEXT("External Referencers count: %d"), InstInspInfo.InspectedInstance.CachedExternalReferencers.Num());
-				if (ImGui::CollapsingHeader(Ansi(*InternalRefHeader)))
-				{
-					DrawReferencers(InstInspInfo.InspectedInstance.CachedInternalReferencers, InternalRefHeader);
-				}
-				if (ImGui::CollapsingHeader(Ansi(*ExternalRefHeader), ImGuiTreeNodeFlags_DefaultOpen))
-				{
-					DrawReferencers(InstInspInfo.InspectedInstance.CachedExternalReferencers, InternalRefHeader);
-				}
-			}
-			else
-			{
-				ImGui::Text("Inspected Instance Invalid / Stale / Null - Please select an instance in the list above.");
-			}
+	void DrawTextureStreamingTelemetry()
+	{
+		FTextureStreamingTelemetry& Telemetry = TextureStreamingTelemetry;
+		using ESeries = FTextureStreamingTelemetry::ESeries;
 
-			ImGui::EndChild(); // "InspectedInstance"
+		ImGui::Checkbox("Record", &Telemetry.bEnabled);
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::SetTooltip("Each sample visits every streaming texture, spread over as many frames as the ms/frame budget needs.");
+		}
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(80.0f);
+		ImGui::DragInt("Sample Every N Frames", &Telemetry.SampleEveryNFrames, 0.2f, 1, 600);
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(80.0f);
+		ImGui::DragFloat("ms/frame##StreamingTelemetry", &Telemetry.PassBudgetMs, 0.05f, 0.1f, 50.0f, "%.02f");
+		ImGui::SameLine();
+		if (ImGui::SmallButton("Reset##StreamingTelemetry"))
+		{
+			Telemetry.Reset();
+		}
+		ImGui::SameLine();
+		ImGui::Text("%d / %d samples", Telemetry.GetNumSamples(), FTextureStreamingTelemetry::NumSamples);
+
+		if (Telemetry.GetNumSamples() == 0)
+		{
+			return;
 		}
+
+		// Memory series share a scale so required and resident can be compared against the pool size.
+		const float MemoryScaleMax = FMath::Max3(Telemetry.GetMaxSample(ESeries::PoolSizeMB), Telemetry.GetMaxSample(ESeries::RequiredMB), Telemetry.GetMaxSample(ESeries::ResidentMB));
+		const float PlotHeight = 50.0f;
+		Telemetry.DrawSeries(ESeries::PoolSizeMB, "Pool Size (MB)", "%.0f MB (max %.0f)", MemoryScaleMax, PlotHeight);
+		Telemetry.DrawSeries(ESeries::RequiredMB, "Required (MB)", "%.0f MB (max %.0f)", MemoryScaleMax, PlotHeight);
+		Telemetry.DrawSeries(ESeries::ResidentMB, "Resident (MB)", "%.0f MB (max %.0f)", MemoryScaleMax, PlotHeight);
+		Telemetry.DrawSeries(ESeries::OverBudgetMB, "Over Budget (MB)", "%.0f MB (max %.0f)", FLT_MAX, PlotHeight);
+		Telemetry.DrawSeries(ESeries::PendingMips, "Pending Mip Requests", "%.0f textures (max %.0f)", FLT_MAX, PlotHeight);
+		Telemetry.DrawSeries(ESeries::DroppingMips, "Dropping Mips", "%.0f textures (max %.0f)", FLT_MAX, PlotHeight);
+		Telemetry.DrawSeries(ESeries::WantingResources, "Wanting Resources", "%.0f (max %.0f)", FLT_MAX, PlotHeight);
 	}
 }
 
@@ -910,134 +5476,83 @@ void FImGuiMemoryDebugger::ImGuiUpdate(float DeltaTime)
 
 	if (ImGui::CollapsingHeader("Texture Memory"))
 	{
-		ImGui::Text("Currently Loaded Textures: "); ImGui::SameLine();
-		enum ETextureListMode
-		{
-			All,
-			Streaming,
-			NonStreaming,
-			Forced
-		};
-		static int TextureMode = 0;
-		if (ImGui::RadioButton("All", TextureMode == ETextureListMode::All)) { TextureMode = ETextureListMode::All; } ImGui::SameLine();
-		if (ImGui::RadioButton("Streaming", TextureMode == ETextureListMode::Streaming)) { TextureMode = ETextureListMode::Streaming; } ImGui::SameLine();
-		if (ImGui::RadioButton("NonStreaming", TextureMode == ETextureListMode::NonStreaming)) { TextureMode = ETextureListMode::NonStreaming; } ImGui::SameLine();
-		if (ImGui::RadioButton("Forced", TextureMode == ETextureListMode::Forced)) { TextureMode = ETextureListMode::Forced; } ImGui::SameLine();
-		static bool bAlphaSort = false;
-		ImGui::Checkbox("Alpha Sort", &bAlphaSort);
-		ImGui::Separator();
+		MemDebugUtils::FTextureSnapshot& TextureSnapshot = MemDebugUtils::TextureSnapshot;
+		TextureSnapshot.LastViewFrame = GFrameCounter;
 
-		// Find out how many primitive components reference a texture.
-		TMap<UTexture2D*, int32> TextureToUsageMap;
-		for (TObjectIterator<UPrimitiveComponent> It; It; ++It)
+		if (TextureSnapshot.IsGathering())
 		{
-			UPrimitiveComponent* PrimitiveComponent = *It;
-
-			// Use the existing texture streaming functionality to gather referenced textures. Worth noting
-			// that GetStreamingTextureInfo doesn't check whether a texture is actually streamable or not
-			// and is also implemented for skeletal meshes and such.
-#if ENGINE_MAJOR_VERSION == 4
-			ImGuiDebugToolsUtils::FStreamingTextureLevelContext LevelContext(EMaterialQualityLevel::Num, PrimitiveComponent);
-#elif ENGINE_MAJOR_VERSION == 5
-			FStreamingTextureLevelContext LevelContext(EMaterialQualityLevel::Num, PrimitiveComponent);
-#endif
-			TArray<FStreamingRenderAssetPrimitiveInfo> StreamingTextures;
-			PrimitiveComponent->GetStreamingRenderAssetInfo((FStreamingTextureLevelContext&)LevelContext, StreamingTextures);
-
-			//// Increase usage count for all referenced textures
-			for (int32 TextureIndex = 0; TextureIndex < StreamingTextures.Num(); TextureIndex++)
+			ImGui::ProgressBar(TextureSnapshot.GetGatherProgress(), ImVec2(100.0f, 0.0f));
+			ImGui::SameLine();
+			if (ImGui::SmallButton("Cancel"))
 			{
-				UTexture2D* Texture = Cast<UTexture2D>(StreamingTextures[TextureIndex].RenderAsset);
-				if (Texture)
-				{
-					// Initializes UsageCount to 0 if texture is not found.
-					int32 UsageCount = TextureToUsageMap.FindRef(Texture);
-					TextureToUsageMap.Add(Texture, UsageCount + 1);
-				}
+				TextureSnapshot.CancelGather();
 			}
 		}
-		int32 NumApplicableToMinSize = 0;
-		// Collect textures.
-		TArray<MemDebugUtils::FSortedTexture> SortedTextures;
-		for (TObjectIterator<UTexture> It; It; ++It)
+		else
 		{
-			UTexture* Texture = *It;
-			UTexture2D* Texture2D = Cast<UTexture2D>(Texture);
-			UTextureCube* TextureCube = Cast<UTextureCube>(Texture);
-
-			int32 LODGroup = Texture->LODGroup;
-			int32 NumMips = 0;
-			int32 MaxResLODBias = 0;
-			int32 MaxAllowedSizeX = 0;
-			int32 MaxAllowedSizeY = 0;
-			EPixelFormat Format = PF_Unknown;
-			int32 DroppedMips = 0;
-			int32 CurSizeX = 0;
-			int32 CurSizeY = 0;
-			bool bIsStreamingTexture = false;
-			int32 MaxAllowedSize = Texture->CalcTextureMemorySizeEnum(TMC_AllMipsBiased);
-			int32 CurrentSize = Texture->CalcTextureMemorySizeEnum(TMC_ResidentMips);
-			int32 UsageCount = 0;
-			bool bIsForced = false;
-
-			if (Texture2D != nullptr)
+			if (ImGui::Button("Refresh"))
 			{
-				NumMips = Texture2D->GetNumMips();
-				MaxResLODBias = NumMips - Texture2D->GetNumMipsAllowed(false);
-				MaxAllowedSizeX = FMath::Max<int32>(Texture2D->GetSizeX() >> MaxResLODBias, 1);
-				MaxAllowedSizeY = FMath::Max<int32>(Texture2D->GetSizeY() >> MaxResLODBias, 1);
-				Format = Texture2D->GetPixelFormat();
-				DroppedMips = Texture2D->GetNumMips() - Texture2D->GetNumResidentMips();
-				CurSizeX = FMath::Max<int32>(Texture2D->GetSizeX() >> DroppedMips, 1);
-				CurSizeY = FMath::Max<int32>(Texture2D->GetSizeY() >> DroppedMips, 1);
-				bIsStreamingTexture = Texture2D->GetStreamingIndex() != INDEX_NONE;
-				UsageCount = TextureToUsageMap.FindRef(Texture2D);
-				bIsForced = Texture2D->ShouldMipLevelsBeForcedResident() && bIsStreamingTexture;
-
-				if ((NumMips >= Texture2D->GetMinTextureResidentMipCount()) && bIsStreamingTexture)
-				{
-					NumApplicableToMinSize++;
-				}
+				TextureSnapshot.BeginGather();
 			}
-			else if (TextureCube != nullptr)
+			if (TextureSnapshot.HasSnapshot())
 			{
-				NumMips = TextureCube->GetNumMips();
-				Format = TextureCube->GetPixelFormat();
+				ImGui::SameLine();
+				ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "%.01f s old, gathered in %.01f ms", TextureSnapshot.GetSnapshotAge(), TextureSnapshot.LastGatherDurationMs);
 			}
-
-			if (((TextureMode == ETextureListMode::Streaming) && bIsStreamingTexture) ||
-				((TextureMode == ETextureListMode::NonStreaming) && !bIsStreamingTexture) ||
-				((TextureMode == ETextureListMode::Forced) && bIsForced) ||
-				(TextureMode == ETextureListMode::All))
+			if (TextureSnapshot.bGatherCancelled)
 			{
-				new (SortedTextures) MemDebugUtils::FSortedTexture(MaxAllowedSizeX, MaxAllowedSizeY, Format, CurSizeX, CurSizeY, MaxResLODBias, MaxAllowedSize, CurrentSize,
-													Texture->GetPathName(), LODGroup, bIsStreamingTexture, UsageCount);
+				ImGui::SameLine();
+				ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "(cancelled, auto refresh paused until Refresh)");
 			}
 		}
+		ImGui::SameLine();
+		ImGui::Checkbox("Auto Refresh", &TextureSnapshot.bAutoRefresh);
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(80.0f);
+		ImGui::DragFloat("Interval (s)##TextureRefresh", &TextureSnapshot.RefreshInterval, 0.1f, 1.0f, 600.0f, "%.01f");
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(80.0f);
+		ImGui::DragFloat("ms/frame##TextureGather", &TextureSnapshot.GatherBudgetMs, 0.05f, 0.1f, 50.0f, "%.02f");
 
-		// Retrieve mapping from LOD group enum value to text representation.
-		TArray<FString> TextureGroupNames = UTextureLODSettings::GetTextureGroupNames();
-
-		TArray<uint64> TextureGroupCurrentSizes;
-		TArray<uint64> TextureGroupMaxAllowedSizes;
-
-		TArray<uint64> FormatCurrentSizes;
-		TArray<uint64> FormatMaxAllowedSizes;
+		ImGui::Text("Currently Loaded Textures: "); ImGui::SameLine();
+		static MemDebugUtils::ETextureListMode::Type TextureMode = MemDebugUtils::ETextureListMode::All;
+		if (ImGui::RadioButton("All", TextureMode == MemDebugUtils::ETextureListMode::All)) { TextureMode = MemDebugUtils::ETextureListMode::All; } ImGui::SameLine();
+		if (ImGui::RadioButton("Streaming", TextureMode == MemDebugUtils::ETextureListMode::Streaming)) { TextureMode = MemDebugUtils::ETextureListMode::Streaming; } ImGui::SameLine();
+		if (ImGui::RadioButton("NonStreaming", TextureMode == MemDebugUtils::ETextureListMode::NonStreaming)) { TextureMode = MemDebugUtils::ETextureListMode::NonStreaming; } ImGui::SameLine();
+		if (ImGui::RadioButton("Forced", TextureMode == MemDebugUtils::ETextureListMode::Forced)) { TextureMode = MemDebugUtils::ETextureListMode::Forced; } ImGui::SameLine();
+		if (ImGui::RadioButton("Unreferenced", TextureMode == MemDebugUtils::ETextureListMode::Unreferenced)) { TextureMode = MemDebugUtils::ETextureListMode::Unreferenced; } ImGui::SameLine();
+		static bool bAlphaSort = false;
+		ImGui::Checkbox("Alpha Sort", &bAlphaSort);
+		if (TextureSnapshot.NameFilter.Draw("Name Filter##Textures", 300.0f))
+		{
+			TextureSnapshot.bNameFilterDirty = true;
+		}
+		ImGui::Separator();
 
-		TextureGroupCurrentSizes.AddZeroed(TextureGroupNames.Num());
-		TextureGroupMaxAllowedSizes.AddZeroed(TextureGroupNames.Num());
+		TextureSnapshot.UpdateVisibleTextures(TextureMode, bAlphaSort);
 
-		FormatCurrentSizes.AddZeroed(PF_MAX);
-		FormatMaxAllowedSizes.AddZeroed(PF_MAX);
+		if (ImGui::TreeNode("Budgets"))
+		{
+			MemDebugUtils::DrawTextureBudgets(TextureSnapshot);
+			ImGui::TreePop();
+			ImGui::Separator();
+		}
+		if (ImGui::TreeNode("Unreferenced Resident Textures"))
+		{
+			MemDebugUtils::UnreferencedTextureReport.Draw(TextureSnapshot);
+			ImGui::TreePop();
+			ImGui::Separator();
+		}
+		if (ImGui::TreeNode("Audit"))
+		{
+			MemDebugUtils::TextureAudit.Draw(TextureSnapshot);
+			ImGui::TreePop();
+			ImGui::Separator();
+		}
 
 		// Display.
-		uint64 TotalMaxAllowedSize = 0;
-		uint64 TotalCurrentSize = 0;
 		ImGui::BeginChild("TextureList", ImVec2(0, 500.0f));
 
-		// Sort textures by cost.
-		SortedTextures.Sort(MemDebugUtils::FCompareFSortedTexture(bAlphaSort));
-
 		ImGui::Columns(7);
 		static float ColumnWidths[7];
 		for (int i = 0; i <= 6; ++i)
@@ -1055,39 +5570,31 @@ void FImGuiMemoryDebugger::ImGuiUpdate(float DeltaTime)
 		ImGui::Separator();
 		ImGui::BeginChild("TextureListContents", ImVec2(0, ImGui::GetFrameHeight() - 60.0f));
 		ImGui::Columns(7);
-		for (int32 TextureIndex = 0; TextureIndex < SortedTextures.Num(); TextureIndex++)
+		const int32 SelectedTextureIndex = TextureSnapshot.GetSelectedTextureIndex();
+		ImGuiListClipper Clipper;
+		Clipper.Begin(TextureSnapshot.VisibleIndices.Num());
+		while (Clipper.Step())
 		{
-			const MemDebugUtils::FSortedTexture& SortedTexture = SortedTextures[TextureIndex];
-			const bool bValidTextureGroup = TextureGroupNames.IsValidIndex(SortedTexture.LODGroup);
-
-			FString AuthoredBiasString(TEXT("?"));
-			if (!FPlatformProperties::RequiresCookedData())
-			{
-				AuthoredBiasString.Empty();
-				AuthoredBiasString.AppendInt(SortedTexture.LODBias);
-			}
-			ImGui::Text(" %i KB, %s- %ix%i", (SortedTexture.MaxAllowedSize + 512) / 1024, Ansi(*AuthoredBiasString), SortedTexture.MaxAllowedSizeX, SortedTexture.MaxAllowedSizeY); ImGui::NextColumn();
-			ImGui::Text("%i KB- %ix%i", (SortedTexture.CurrentSize + 512) / 1024, SortedTexture.CurSizeX, SortedTexture.CurSizeY); ImGui::NextColumn();
-			ImGui::Text("%s", Ansi(GetPixelFormatString(SortedTexture.Format))); ImGui::NextColumn();
-			ImGui::Text("%s", bValidTextureGroup ? Ansi(*TextureGroupNames[SortedTexture.LODGroup]) : "INVALID"); ImGui::NextColumn();
-			ImGui::Text("%s", Ansi(*SortedTexture.Name)); ImGui::NextColumn();
-			ImGui::Text("%s", SortedTexture.bIsStreaming ? "YES" : "NO"); ImGui::NextColumn();
-			ImGui::Text("%i", SortedTexture.UsageCount); ImGui::NextColumn();
-
-			if (bValidTextureGroup)
+			for (int RowIndex = Clipper.DisplayStart; RowIndex < Clipper.DisplayEnd; ++RowIndex)
 			{
-				TextureGroupCurrentSizes[SortedTexture.LODGroup] += SortedTexture.CurrentSize;
-				TextureGroupMaxAllowedSizes[SortedTexture.LODGroup] += SortedTexture.MaxAllowedSize;
-			}
+				using EDisplayString = MemDebugUtils::FTextureSnapshot::EDisplayString;
+				const int32 TextureIndex = TextureSnapshot.VisibleIndices[RowIndex];
+				const MemDebugUtils::FSortedTexture& SortedTexture = TextureSnapshot.Textures[TextureIndex];
 
-			if (SortedTexture.Format >= 0 && SortedTexture.Format < PF_MAX)
-			{
-				FormatCurrentSizes[SortedTexture.Format] += SortedTexture.CurrentSize;
-				FormatMaxAllowedSizes[SortedTexture.Format] += SortedTexture.MaxAllowedSize;
+				ImGui::PushID(TextureIndex);
+				if (ImGui::Selectable(TextureSnapshot.GetDisplayString(TextureIndex, EDisplayString::OnDisk), SelectedTextureIndex == TextureIndex, ImGuiSelectableFlags_SpanAllColumns))
+				{
+					TextureSnapshot.SelectTexture(TextureIndex);
+				}
+				ImGui::PopID();
+				ImGui::NextColumn();
+				ImGui::TextUnformatted(TextureSnapshot.GetDisplayString(TextureIndex, EDisplayString::InMem)); ImGui::NextColumn();
+				ImGui::TextUnformatted(TextureSnapshot.GetDisplayString(TextureIndex, EDisplayString::Format)); ImGui::NextColumn();
+				ImGui::TextUnformatted(TextureSnapshot.GetDisplayString(TextureIndex, EDisplayString::LODGroup)); ImGui::NextColumn();
+				ImGui::TextUnformatted(TextureSnapshot.GetDisplayString(TextureIndex, EDisplayString::Name)); ImGui::NextColumn();
+				ImGui::TextUnformatted(SortedTexture.bIsStreaming ? "YES" : "NO"); ImGui::NextColumn();
+				ImGui::Text("%i", SortedTexture.UsageCount); ImGui::NextColumn();
 			}
-
-			TotalMaxAllowedSize += SortedTexture.MaxAllowedSize;
-			TotalCurrentSize += SortedTexture.CurrentSize;
 		}
 		for (int i = 0; i <= 6; ++i)
 		{
@@ -1103,37 +5610,85 @@ void FImGuiMemoryDebugger::ImGuiUpdate(float DeltaTime)
 		ImGui::Text("Count"); ImGui::NextColumn();
 		ImGui::Text("CountApplicableToMin"); ImGui::NextColumn();
 
-		ImGui::Text("%.2f MB", (double)TotalMaxAllowedSize / 1024. / 1024.); ImGui::NextColumn();
-		ImGui::Text("%.2f MB", (double)TotalCurrentSize / 1024. / 1024.); ImGui::NextColumn();
-		ImGui::Text("%d", SortedTextures.Num()); ImGui::NextColumn();
-		ImGui::Text("%d", NumApplicableToMinSize); ImGui::NextColumn();
+		ImGui::Text("%.2f MB", (double)TextureSnapshot.TotalMaxAllowedSize / 1024. / 1024.); ImGui::NextColumn();
+		ImGui::Text("%.2f MB", (double)TextureSnapshot.TotalCurrentSize / 1024. / 1024.); ImGui::NextColumn();
+		ImGui::Text("%d", TextureSnapshot.VisibleIndices.Num()); ImGui::NextColumn();
+		ImGui::Text("%d", TextureSnapshot.NumApplicableToMinSize); ImGui::NextColumn();
 
 		ImGui::Columns(1);
 		ImGui::EndChild(); // "TextureList"
+
+		MemDebugUtils::DrawTextureUsers(TextureSnapshot);
 	}
 
 
+	if (ImGui::CollapsingHeader("Texture Streaming"))
+	{
+		MemDebugUtils::DrawTextureStreamingTelemetry();
+	}
+
 	if (ImGui::CollapsingHeader("Object Memory"))
 	{
 		static MemDebugUtils::EMemSortType::Type SortMode = MemDebugUtils::EMemSortType::TotalMem;
-		static MemDebugUtils::FCachedClassTree CachedClassTree;
+		MemDebugUtils::FCachedClassTree& CachedClassTree = MemDebugUtils::CachedClassTree;
 		static bool IncludeCDO = false;
-		CachedClassTree.TryCacheEntries();
 		static EResourceSizeMode::Type ResourceSizeMode = EResourceSizeMode::EstimatedTotal;
+		static MemDebugUtils::ECaptureMode::Type CaptureMode = MemDebugUtils::ECaptureMode::GameThread;
+		static bool AutoUpdateOnStale = true;
+
+		// Splice in any newly loaded classes. If cached classes were destroyed, the snapshot is stale.
+		if (CachedClassTree.TryCacheEntries() && AutoUpdateOnStale)
+		{
+			CachedClassTree.BeginCapture(IncludeCDO, ResourceSizeMode);
+		}
+
 		ImGui::Columns(3);
-		if (ImGui::Button("Update (SLOW!)"))
+		if (CachedClassTree.IsCapturing())
+		{
+			ImGui::ProgressBar(CachedClassTree.GetCaptureProgress(), ImVec2(100.0f, 0.0f));
+			ImGui::SameLine();
+			if (ImGui::SmallButton("Cancel"))
+			{
+				CachedClassTree.CancelCapture();
+			}
+		}
+		else
 		{
-			CachedClassTree.UpdateMemoryStats(IncludeCDO, ResourceSizeMode);
-			CachedClassTree.SortBy(SortMode);
+			if (ImGui::Button("Update (SLOW!)"))
+			{
+				if (CaptureMode == MemDebugUtils::ECaptureMode::TimeSliced)
+				{
+					CachedClassTree.BeginCapture(IncludeCDO, ResourceSizeMode);
+				}
+				else
+				{
+					CachedClassTree.UpdateMemoryStats(IncludeCDO, ResourceSizeMode, CaptureMode);
+					CachedClassTree.SortBy(SortMode);
+				}
+			}
+			if (CachedClassTree.LastUpdateDurationMs > 0.0)
+			{
+				ImGui::SameLine();
+				ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "%.01f ms", CachedClassTree.LastUpdateDurationMs);
+			}
 		}
 
-		static bool AutoUpdateOnStale = true;
 		ImGui::Checkbox("Update on Stale", &AutoUpdateOnStale);
 		ImGui::BeginChild("##ResourceSizeModeComboMain", ImVec2(210.0f, 18.0f));
 		static int ResourceSizeModeComboValue = static_cast<int>(ResourceSizeMode);
 		ImGui::Combo("##ResourceSizeModeCombo", &ResourceSizeModeComboValue, "Exclusive\0Estimated Total");
 		ResourceSizeMode = static_cast<EResourceSizeMode::Type>(ResourceSizeModeComboValue);
 		ImGui::EndChild();
+		ImGui::BeginChild("##CaptureModeComboMain", ImVec2(210.0f, 18.0f));
+		static int CaptureModeComboValue = static_cast<int>(CaptureMode);
+		ImGui::Combo("##CaptureModeCombo", &CaptureModeComboValue, "Game Thread\0Parallel\0Time Sliced");
+		CaptureMode = static_cast<MemDebugUtils::ECaptureMode::Type>(CaptureModeComboValue);
+		ImGui::EndChild();
+		if (CaptureMode == MemDebugUtils::ECaptureMode::TimeSliced)
+		{
+			ImGui::SetNextItemWidth(80.0f);
+			ImGui::DragFloat("ms/frame", &CachedClassTree.CaptureBudgetMs, 0.05f, 0.1f, 50.0f, "%.02f");
+		}
 		ImGui::SetColumnWidth(0, 150.0f);
 		ImGui::NextColumn();
 		ImGui::Text("Include/Sort:");
@@ -1196,13 +5751,67 @@ void FImGuiMemoryDebugger::ImGuiUpdate(float DeltaTime)
 		ImGui::NextColumn();
 		static ImGuiTextFilter ClassNameFilter;
 		static bool FilterZeroInstances = false;
-		ClassNameFilter.Draw("Name Filter", ImGui::GetColumnWidth() - 100.0f);
-		ImGui::Checkbox("Filter 0 instances", &FilterZeroInstances);
+		if (ClassNameFilter.Draw("Name Filter", ImGui::GetColumnWidth() - 100.0f))
+		{
+			MemDebugUtils::ClassTreeView.OnFilterChanged();
+			MemDebugUtils::SnapshotBrowser.bVisibleRowsDirty = true;
+		}
+		if (ImGui::Checkbox("Filter 0 instances", &FilterZeroInstances))
+		{
+			MemDebugUtils::ClassTreeView.MarkDirty();
+		}
 		ImGui::Checkbox("Include CDO", &IncludeCDO);
+		MemDebugUtils::LiveObjectCounter.bIncludeCDO = IncludeCDO;
+		bool LiveCounts = MemDebugUtils::LiveObjectCounter.IsEnabled();
+		if (ImGui::Checkbox("Live Counts", &LiveCounts))
+		{
+			if (LiveCounts)
+			{
+				MemDebugUtils::LiveObjectCounter.Enable();
+			}
+			else
+			{
+				MemDebugUtils::LiveObjectCounter.Disable();
+			}
+		}
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::SetTooltip("Keep instance counts and spawn/destroy rates current using UObject create/delete listeners. Memory sizes still come from the last update.");
+		}
+		ImGui::Checkbox("Keep Instance Data", &CachedClassTree.bKeepInstanceRecords);
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::SetTooltip("Keep per-instance sizes from each update, so Inspect opens instantly without rescanning every object.");
+		}
+		ImGui::Checkbox("Retained Size", &MemDebugUtils::bRetainedSizeMode);
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::SetTooltip("Show the memory that would be freed if an object (or every instance of a class) were released.\nComputed in the background from a dominator tree over the reference graph, using exclusive resource sizes.");
+		}
+		MemDebugUtils::DrawRetainedSizeProgress();
+		ImGui::SetNextItemWidth(150.0f);
+		int GroupingComboValue = static_cast<int>(MemDebugUtils::ClassTreeGrouping);
+		if (ImGui::Combo("Group By", &GroupingComboValue, MemDebugUtils::InstanceGroupingComboItems))
+		{
+			MemDebugUtils::ClassTreeGrouping = static_cast<MemDebugUtils::EInstanceGrouping::Type>(GroupingComboValue);
+		}
+		ShowCols.GetShowCol(MemDebugUtils::EColumnTypes::RetainedMem) = MemDebugUtils::bRetainedSizeMode;
+		ShowCols.GetShowCol(MemDebugUtils::EColumnTypes::Growth) = MemDebugUtils::ClassGrowthTracker.IsEnabled();
 		ImGui::Columns(1);
+
+		if (ImGui::TreeNode("Snapshots"))
+		{
+			MemDebugUtils::DrawSnapshotControls(CachedClassTree);
+			ImGui::TreePop();
+		}
+		if (ImGui::TreeNode("Growth Tracking"))
+		{
+			MemDebugUtils::DrawGrowthTrackingControls(CachedClassTree);
+			ImGui::TreePop();
+		}
 		
 		ImGui::BeginChild("ClassListHeader", ImVec2(0, 30.0f), true);
-		static constexpr int ColumnCount = 8;
+		static constexpr int ColumnCount = 10;
 		const int VisibleColCount = ShowCols.CacheShowColCount() + 1;
 		ImGui::Columns(VisibleColCount, "ObjMemCol");
 		static float ColumnWidths[ColumnCount];
@@ -1220,13 +5829,15 @@ void FImGuiMemoryDebugger::ImGuiUpdate(float DeltaTime)
 			}
 		}
 		ImGui::Text("Class"); ImGui::NextColumn();
-		if (ShowCols.GetShowCol(MemDebugUtils::EColumnTypes::Instances)) { ImGui::Text("InstanceCount"); ImGui::NextColumn(); }
+		if (ShowCols.GetShowCol(MemDebugUtils::EColumnTypes::Instances)) { ImGui::Text(MemDebugUtils::LiveObjectCounter.IsEnabled() ? "Live Instances" : "InstanceCount"); ImGui::NextColumn(); }
 		if (ShowCols.GetShowCol(MemDebugUtils::EColumnTypes::TotalMem)) { ImGui::Text("Total Mem"); ImGui::NextColumn(); }
 		if (ShowCols.GetShowCol(MemDebugUtils::EColumnTypes::UnknownMem)) { ImGui::Text("Unknown Mem"); ImGui::NextColumn(); }
 		if (ShowCols.GetShowCol(MemDebugUtils::EColumnTypes::DedSysMem)) { ImGui::Text("DedSys Mem"); ImGui::NextColumn(); }
 		if (ShowCols.GetShowCol(MemDebugUtils::EColumnTypes::DedVidMem)) { ImGui::Text("DedVid Mem"); ImGui::NextColumn(); }
 		if (ShowCols.GetShowCol(MemDebugUtils::EColumnTypes::SharedSysMem)) { ImGui::Text("SharedSys Mem"); ImGui::NextColumn(); }
 		if (ShowCols.GetShowCol(MemDebugUtils::EColumnTypes::SharedVidMem)) { ImGui::Text("SharedVid Mem"); ImGui::NextColumn(); }
+		if (ShowCols.GetShowCol(MemDebugUtils::EColumnTypes::RetainedMem)) { ImGui::Text("Retained Mem"); ImGui::NextColumn(); }
+		if (ShowCols.GetShowCol(MemDebugUtils::EColumnTypes::Growth)) { ImGui::Text("Growth"); ImGui::NextColumn(); }
 		ImGui::Columns(1);
 		ImGui::EndChild(); // "ClassListHeader"
 
@@ -1240,21 +5851,33 @@ void FImGuiMemoryDebugger::ImGuiUpdate(float DeltaTime)
 			}
 		}
 		
-		if (!MemDebugUtils::DrawClassChildTreeIndex(CachedClassTree, CachedClassTree.RootIndex, FilterZeroInstances, ClassNameFilter, ShowCols))
+		if (MemDebugUtils::SnapshotBrowser.bDiffMode)
+		{
+			MemDebugUtils::DrawSnapshotDiff(SortMode, ClassNameFilter, ShowCols);
+		}
+		else if (MemDebugUtils::ClassTreeGrouping != MemDebugUtils::EInstanceGrouping::None)
+		{
+			MemDebugUtils::DrawClassTreeGroups(CachedClassTree);
+		}
+		else if (!MemDebugUtils::DrawClassTreeRows(CachedClassTree, MemDebugUtils::ClassTreeView, FilterZeroInstances, ClassNameFilter, ShowCols))
 		{
-			if (AutoUpdateOnStale)
+			if (CachedClassTree.IsCapturing())
+			{
+				// A class went stale mid-capture. Class entries are refreshed once the capture finishes, so just let it run to completion.
+			}
+			else if (AutoUpdateOnStale)
 			{
-				// Update on Stale will be slow, but will run full memory stats when class data goes stale.
-				CachedClassTree.UpdateMemoryStats(IncludeCDO, ResourceSizeMode);
+				// Update on Stale kicks off a time-sliced capture, so going stale never hitches the game with a full blocking rescan.
+				CachedClassTree.BeginCapture(IncludeCDO, ResourceSizeMode);
 			}
 			else
 			{
 				// If not auto updating, at least re-fetch Class data, which is quick and allows us to show something
 				CachedClassTree.TryCacheEntries(/*ForceRecache*/ true);
-			}
 
-			// re-sort
-			CachedClassTree.SortBy(SortMode);
+				// re-sort
+				CachedClassTree.SortBy(SortMode);
+			}
 		}
 		ImGui::Columns(1);
 
@@ -1266,6 +5889,15 @@ void FImGuiMemoryDebugger::UpdateTool(float DeltaTime)
 {
 	FImGuiToolWindow::UpdateTool(DeltaTime);
 
+	// Progress any time-sliced object memory capture, even while the Object Memory header is collapsed.
+	MemDebugUtils::CachedClassTree.TickCapture();
+	MemDebugUtils::LiveObjectCounter.UpdateClassTotals(MemDebugUtils::CachedClassTree);
+	MemDebugUtils::ClassGrowthTracker.Tick(MemDebugUtils::CachedClassTree);
+	MemDebugUtils::ReferenceGraph.Tick(MemDebugUtils::ReferenceGraphBudgetMs);
+	MemDebugUtils::UpdateRetainedSizes(MemDebugUtils::CachedClassTree);
+	MemDebugUtils::TextureSnapshot.Tick();
+	MemDebugUtils::TextureStreamingTelemetry.Tick();
+
 	for (int i = MemDebugUtils::InstanceInspectors.Num() - 1; i >= 0; --i)
 	{
 		MemDebugUtils::FInstanceInspectorInfo& InstInsp = MemDebugUtils::InstanceInspectors[i];
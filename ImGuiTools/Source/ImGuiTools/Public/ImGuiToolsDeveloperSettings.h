@@ -3,9 +3,24 @@
 #pragma once
 
 #include <Engine/DeveloperSettings.h>
+#include <Engine/TextureDefines.h>
 
 #include "ImGuiToolsDeveloperSettings.generated.h"
 
+// Resident memory budget for the textures of one LOD group, checked by the Memory Debugger's texture budget panel.
+USTRUCT()
+struct FImGuiToolsTextureGroupBudget
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere)
+	TEnumAsByte<TextureGroup> LODGroup = TEXTUREGROUP_World;
+
+	// In MB. Groups without a budget (or a budget of 0) are shown but never flagged.
+	UPROPERTY(EditAnywhere, meta = (ClampMin = 0))
+	float BudgetMB = 0.0f;
+};
+
 UCLASS(config = ImGui, meta = (DisplayName = "ImGui Tools Settings"))
 class IMGUITOOLS_API UImGuiToolsDeveloperSettings : public UDeveloperSettings
 {
@@ -29,4 +44,13 @@ public:
 	// Array of keys for a key chord, defining a key short cut to toggle ImGui Visibility.
 	UPROPERTY(config, EditAnywhere)
 	TArray<FKey> ImGuiToggleVisibilityKeys;
+
+	// Classes whose GetResourceSizeEx() is not safe to call off the game thread. When the Memory Debugger gathers object memory in parallel,
+	//	instances of these classes (and their child classes) are gathered on the game thread instead.
+	UPROPERTY(config, EditAnywhere)
+	TArray<TSoftClassPtr<UObject>> MemoryDebuggerGameThreadOnlyClasses;
+
+	// Per LOD group texture memory budgets shown in the Memory Debugger. Groups whose resident texture memory goes over budget are highlighted.
+	UPROPERTY(config, EditAnywhere)
+	TArray<FImGuiToolsTextureGroupBudget> MemoryDebuggerTextureGroupBudgets;
 };
\ No newline at end of file